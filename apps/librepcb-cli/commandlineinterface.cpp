@@ -516,6 +516,7 @@ bool CommandLineInterface::openProject(
       projectFileName = projectFp.getFilename();
     }
     ProjectLoader loader;
+    loader.setLoadBoardsOnDemand(true);
     std::unique_ptr<Project> project =
         loader.open(std::unique_ptr<TransactionalDirectory>(
                         new TransactionalDirectory(projectFs)),
@@ -589,6 +590,20 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    // Load boards only if needed, e.g. not for exporting a generic BOM. Note
+    // that symbol texts in schematics show data of the primary board.
+    const bool boardsNeeded = runErc || runDrc || (!runJobs.isEmpty()) ||
+        runAllJobs || (!exportBoardBomFiles.isEmpty()) ||
+        exportPcbFabricationData || (!exportPnpTopFiles.isEmpty()) ||
+        (!exportPnpBottomFiles.isEmpty()) || (!exportNetlistFiles.isEmpty()) ||
+        (!boardNames.isEmpty()) || (!boardIndices.isEmpty()) ||
+        removeOtherBoards || strict;
+    if (boardsNeeded) {
+      project->loadBoards();  // can throw
+    } else if (!exportSchematicsFiles.isEmpty()) {
+      project->loadBoards(1);  // can throw
+    }
+
     // Parse list of boards.
     QList<Board*> boards;
     foreach (const QString& boardName, boardNames) {
@@ -629,7 +644,7 @@ bool CommandLineInterface::openProject(
     }
 
     // If no boards are specified, export all boards.
-    if (boardNames.isEmpty() && boardIndices.isEmpty()) {
+    if (boardNames.isEmpty() && boardIndices.isEmpty() && boardsNeeded) {
       boards = project->getBoards();
     }
 
@@ -711,7 +726,7 @@ bool CommandLineInterface::openProject(
         print("  " % tr("Board '%1':").arg(*board->getName()));
         BoardDesignRuleCheck drc(
             *board, customSettings ? *customSettings : board->getDrcSettings());
-        drc.execute(false);
+        drc.execute(false, true);
         int approvedMsgCount = 0;
         const QStringList nonApproved = prepareRuleCheckMessages(
             drc.getMessages(), board->getDrcMessageApprovals(),
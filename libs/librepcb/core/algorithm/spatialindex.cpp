@@ -0,0 +1,241 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "spatialindex.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+SpatialIndex::SpatialIndex() noexcept
+  : mItems(),
+    mExtents(emptyRect()),
+    mCellSize(1),
+    mColumns(0),
+    mRows(0),
+    mCells(),
+    mLargeItems() {
+}
+
+SpatialIndex::SpatialIndex(const QVector<ClipperLib::IntRect>& items) noexcept
+  : mItems(items),
+    mExtents(emptyRect()),
+    mCellSize(1),
+    mColumns(0),
+    mRows(0),
+    mCells(),
+    mLargeItems() {
+  // Determine the overall extents and the size of each item.
+  std::vector<ClipperLib::cInt> sizes;
+  sizes.reserve(mItems.count());
+  foreach (const ClipperLib::IntRect& rect, mItems) {
+    if (!isEmpty(rect)) {
+      mExtents = united(mExtents, rect);
+      sizes.push_back(
+          std::max(rect.right - rect.left, rect.bottom - rect.top) + 1);
+    }
+  }
+  if (sizes.empty()) {
+    return;
+  }
+
+  // Use the median item size to determine the cell size since a few very
+  // large items (e.g. planes) would distort the average a lot. Then make sure
+  // the number of cells does not explode if items are very small compared to
+  // the total extents.
+  std::nth_element(sizes.begin(), sizes.begin() + sizes.size() / 2,
+                   sizes.end());
+  mCellSize = std::max(sizes.at(sizes.size() / 2) * 2, ClipperLib::cInt(1));
+  const ClipperLib::cInt width = mExtents.right - mExtents.left + 1;
+  const ClipperLib::cInt height = mExtents.bottom - mExtents.top + 1;
+  const ClipperLib::cInt maxCells =
+      static_cast<ClipperLib::cInt>(sizes.size()) * 4 + 16;
+  while (((width / mCellSize) + 1) * ((height / mCellSize) + 1) > maxCells) {
+    mCellSize *= 2;
+  }
+  mColumns = static_cast<int>(width / mCellSize) + 1;
+  mRows = static_cast<int>(height / mCellSize) + 1;
+  mCells.resize(mColumns * mRows);
+
+  // Insert all items into their cells.
+  for (int i = 0; i < mItems.count(); ++i) {
+    const ClipperLib::IntRect& rect = mItems.at(i);
+    if (isEmpty(rect)) {
+      continue;
+    }
+    const int col0 = cellColumn(rect.left);
+    const int col1 = cellColumn(rect.right);
+    const int row0 = cellRow(rect.top);
+    const int row1 = cellRow(rect.bottom);
+    if ((col1 - col0 + 1) * (row1 - row0 + 1) > sMaxCellsPerItem) {
+      mLargeItems.append(i);
+      continue;
+    }
+    for (int row = row0; row <= row1; ++row) {
+      for (int col = col0; col <= col1; ++col) {
+        mCells[row * mColumns + col].append(i);
+      }
+    }
+  }
+}
+
+SpatialIndex::~SpatialIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QVector<int> SpatialIndex::query(
+    const ClipperLib::IntRect& rect) const noexcept {
+  QVector<int> result;
+  if (isEmpty(rect)) {
+    return result;
+  }
+  foreach (int i, mLargeItems) {
+    if (intersects(mItems.at(i), rect)) {
+      result.append(i);
+    }
+  }
+  if (intersects(mExtents, rect)) {
+    const int col0 = cellColumn(rect.left);
+    const int col1 = cellColumn(rect.right);
+    const int row0 = cellRow(rect.top);
+    const int row1 = cellRow(rect.bottom);
+    for (int row = row0; row <= row1; ++row) {
+      for (int col = col0; col <= col1; ++col) {
+        foreach (int i, mCells.at(row * mColumns + col)) {
+          if (intersects(mItems.at(i), rect)) {
+            result.append(i);
+          }
+        }
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+QVector<int> SpatialIndex::queryNeighbours(int index,
+                                           int minIndex) const noexcept {
+  QVector<int> result = query(mItems.value(index, emptyRect()));
+  auto it = std::lower_bound(result.begin(), result.end(), minIndex);
+  result.erase(result.begin(), it);
+  return result;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+ClipperLib::IntRect SpatialIndex::emptyRect() noexcept {
+  return ClipperLib::IntRect{0, 0, -1, -1};
+}
+
+bool SpatialIndex::isEmpty(const ClipperLib::IntRect& rect) noexcept {
+  return (rect.left > rect.right) || (rect.top > rect.bottom);
+}
+
+bool SpatialIndex::intersects(const ClipperLib::IntRect& a,
+                              const ClipperLib::IntRect& b) noexcept {
+  return (!isEmpty(a)) && (!isEmpty(b)) && (a.left <= b.right) &&
+      (b.left <= a.right) && (a.top <= b.bottom) && (b.top <= a.bottom);
+}
+
+ClipperLib::IntRect SpatialIndex::united(
+    const ClipperLib::IntRect& a, const ClipperLib::IntRect& b) noexcept {
+  if (isEmpty(a)) {
+    return b;
+  } else if (isEmpty(b)) {
+    return a;
+  } else {
+    return ClipperLib::IntRect{
+        std::min(a.left, b.left), std::min(a.top, b.top),
+        std::max(a.right, b.right), std::max(a.bottom, b.bottom)};
+  }
+}
+
+ClipperLib::IntRect SpatialIndex::grown(const ClipperLib::IntRect& rect,
+                                        ClipperLib::cInt offset) noexcept {
+  if (isEmpty(rect)) {
+    return rect;
+  }
+  return ClipperLib::IntRect{rect.left - offset, rect.top - offset,
+                             rect.right + offset, rect.bottom + offset};
+}
+
+ClipperLib::IntRect SpatialIndex::getBounds(
+    const ClipperLib::Path& path) noexcept {
+  if (path.empty()) {
+    return emptyRect();
+  }
+  ClipperLib::IntRect rect{path.front().X, path.front().Y, path.front().X,
+                           path.front().Y};
+  for (const ClipperLib::IntPoint& p : path) {
+    rect.left = std::min(rect.left, p.X);
+    rect.right = std::max(rect.right, p.X);
+    rect.top = std::min(rect.top, p.Y);
+    rect.bottom = std::max(rect.bottom, p.Y);
+  }
+  return rect;
+}
+
+ClipperLib::IntRect SpatialIndex::getBounds(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect rect = emptyRect();
+  for (const ClipperLib::Path& path : paths) {
+    rect = united(rect, getBounds(path));
+  }
+  return rect;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+int SpatialIndex::cellColumn(ClipperLib::cInt x) const noexcept {
+  const ClipperLib::cInt col = (x - mExtents.left) / mCellSize;
+  return static_cast<int>(qBound(ClipperLib::cInt(0), col,
+                                 ClipperLib::cInt(mColumns - 1)));
+}
+
+int SpatialIndex::cellRow(ClipperLib::cInt y) const noexcept {
+  const ClipperLib::cInt row = (y - mExtents.top) / mCellSize;
+  return static_cast<int>(
+      qBound(ClipperLib::cInt(0), row, ClipperLib::cInt(mRows - 1)));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,135 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_SPATIALINDEX_H
+#define LIBREPCB_CORE_SPATIALINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class SpatialIndex
+ ******************************************************************************/
+
+/**
+ * @brief Immutable uniform grid index over axis-aligned bounding boxes
+ *
+ * Allows to quickly find all items whose bounding box overlaps a given
+ * rectangle, e.g. to avoid expensive exact intersection tests (with Clipper)
+ * between objects which are far away from each other.
+ *
+ * Items are identified by their index in the list of bounding boxes passed to
+ * the constructor. Bounding boxes use the Clipper convention, i.e.
+ * `left <= right` and `top <= bottom` (`top` is the minimum Y coordinate).
+ * Boxes with `left > right` or `top > bottom` are considered as empty and
+ * are never returned by any query.
+ *
+ * @note Since the index is immutable after construction, it is safe to query
+ *       it concurrently from multiple threads.
+ */
+class SpatialIndex final {
+public:
+  // Constructors / Destructor
+  SpatialIndex() noexcept;
+  explicit SpatialIndex(const QVector<ClipperLib::IntRect>& items) noexcept;
+  SpatialIndex(const SpatialIndex& other) = default;
+  ~SpatialIndex() noexcept;
+
+  // Getters
+  int getCount() const noexcept { return mItems.count(); }
+  const ClipperLib::IntRect& getBounds(int index) const noexcept {
+    return mItems.at(index);
+  }
+
+  // General Methods
+
+  /**
+   * @brief Find all items overlapping a given rectangle
+   *
+   * @param rect      The area to search for (touching boxes count as
+   *                  overlapping).
+   *
+   * @return Indices of all overlapping items, sorted in ascending order
+   *         and without duplicates.
+   */
+  QVector<int> query(const ClipperLib::IntRect& rect) const noexcept;
+
+  /**
+   * @brief Find all items overlapping the bounding box of a given item
+   *
+   * @param index     Index of the item to search neighbours for.
+   * @param minIndex  Only return items with an index greater or equal than
+   *                  this value. Passing `index + 1` allows to iterate over
+   *                  each overlapping pair exactly once.
+   *
+   * @return Indices of all overlapping items, sorted in ascending order
+   *         and without duplicates.
+   */
+  QVector<int> queryNeighbours(int index, int minIndex = 0) const noexcept;
+
+  // Static Methods
+  static ClipperLib::IntRect emptyRect() noexcept;
+  static bool isEmpty(const ClipperLib::IntRect& rect) noexcept;
+  static bool intersects(const ClipperLib::IntRect& a,
+                         const ClipperLib::IntRect& b) noexcept;
+  static ClipperLib::IntRect united(const ClipperLib::IntRect& a,
+                                    const ClipperLib::IntRect& b) noexcept;
+  static ClipperLib::IntRect grown(const ClipperLib::IntRect& rect,
+                                   ClipperLib::cInt offset) noexcept;
+  static ClipperLib::IntRect getBounds(const ClipperLib::Path& path) noexcept;
+  static ClipperLib::IntRect getBounds(const ClipperLib::Paths& paths) noexcept;
+
+  // Operator Overloadings
+  SpatialIndex& operator=(const SpatialIndex& rhs) = default;
+
+private:  // Methods
+  int cellColumn(ClipperLib::cInt x) const noexcept;
+  int cellRow(ClipperLib::cInt y) const noexcept;
+
+private:  // Data
+  QVector<ClipperLib::IntRect> mItems;
+  ClipperLib::IntRect mExtents;
+  ClipperLib::cInt mCellSize;
+  int mColumns;
+  int mRows;
+  QVector<QVector<int>> mCells;
+
+  /// Items spanning too many cells, these are checked on every query
+  QVector<int> mLargeItems;
+
+  /// Maximum number of cells an item may occupy before it is considered large
+  static constexpr int sMaxCellsPerItem = 64;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
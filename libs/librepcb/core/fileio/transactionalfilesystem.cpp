@@ -30,6 +30,8 @@
 #include <quazip/quazipdir.h>
 #include <quazip/quazipfile.h>
 
+#include <QtConcurrent>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -47,7 +49,8 @@ TransactionalFileSystem::TransactionalFileSystem(
     mIsWritable(writable),
     mLock(filepath),
     mRestoredFromAutosave(false),
-    mMutex(QMutex::Recursive) {
+    mMutex(QMutex::Recursive),
+    mSaveCount(0) {
   // Load the backup if there is one (i.e. last save operation has failed).
   FilePath backupFile = mFilePath.getPathTo(".backup/backup.lp");
   if (backupFile.isExistingFile()) {
@@ -74,6 +77,8 @@ TransactionalFileSystem::TransactionalFileSystem(
 }
 
 TransactionalFileSystem::~TransactionalFileSystem() noexcept {
+  mAutosaveFuture.waitForFinished();
+
   // Remove autosave directory as it is not needed in case the file system
   // was gracefully closed. We only need it if the application has crashed.
   // But if the file system is opened in read-only mode, or if an autosave was
@@ -179,24 +184,49 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
 
 QByteArray TransactionalFileSystem::readIfExists(const QString& path) const {
   const QString cleanedPath = cleanPath(path);
-  QMutexLocker lock(&mMutex);
-  if (mModifiedFiles.contains(cleanedPath)) {
-    return mModifiedFiles.value(cleanedPath);
-  } else if (!isRemoved(cleanedPath)) {
+  QByteArray content;
+  quint64 saveCount = 0;
+  {
+    QMutexLocker lock(&mMutex);
+    if (mModifiedFiles.contains(cleanedPath)) {
+      return mModifiedFiles.value(cleanedPath);
+    } else if (isRemoved(cleanedPath)) {
+      return QByteArray();
+    }
     const FilePath fp = mFilePath.getPathTo(cleanedPath);
-    if (fp.isExistingFile()) {
-      return FileUtils::readFile(fp);  // can throw
+    if (!fp.isExistingFile()) {
+      return QByteArray();
     }
+    content = FileUtils::readFile(fp);  // can throw
+    saveCount = mSaveCount;
+  }
+
+  // Calculate the hash without blocking other threads. If the file system
+  // has been saved in the meantime, the file on disk might have changed.
+  const QByteArray hash = hashContent(content);
+  QMutexLocker lock(&mMutex);
+  if (mSaveCount == saveCount) {
+    mDiskHashes.insert(cleanedPath, hash);
   }
-  return QByteArray();
+  return content;
 }
 
 void TransactionalFileSystem::write(const QString& path,
                                     const QByteArray& content) {
   const QString cleanedPath = cleanPath(path);
+  // Calculate the hash without blocking other threads, files might be large.
+  const QByteArray hash = hashContent(content);
   QMutexLocker lock(&mMutex);
-  mModifiedFiles[cleanedPath] = content;
   mRemovedFiles.remove(cleanedPath);
+  // If the content is identical to the file on disk, there is nothing to
+  // write. This avoids writing (and backing up) unchanged files on save.
+  const auto it = mDiskHashes.constFind(cleanedPath);
+  if ((it != mDiskHashes.constEnd()) && (!isRemoved(cleanedPath)) &&
+      (*it == hash)) {
+    mModifiedFiles.remove(cleanedPath);
+  } else {
+    mModifiedFiles[cleanedPath] = content;
+  }
 }
 
 void TransactionalFileSystem::renameFile(const QString& src,
@@ -356,14 +386,46 @@ QStringList TransactionalFileSystem::checkForModifications() const {
 
 void TransactionalFileSystem::autosave() {
   QMutexLocker lock(&mMutex);
+  mAutosaveFuture.waitForFinished();
   saveDiff("autosave");  // can throw
 }
 
+QFuture<bool> TransactionalFileSystem::startAutosave() {
+  QMutexLocker lock(&mMutex);
+  if (!mIsWritable) {
+    throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
+  }
+
+  // Don't run multiple autosaves in parallel, an older one could otherwise
+  // finish after a newer one.
+  mAutosaveFuture.waitForFinished();
+
+  const FilePath basePath = mFilePath;
+  const QHash<QString, QByteArray> modifiedFiles = mModifiedFiles;
+  const QSet<QString> removedFiles = mRemovedFiles;
+  const QSet<QString> removedDirs = mRemovedDirs;
+  mAutosaveFuture = QtConcurrent::run([=]() {
+    try {
+      saveDiff(basePath, "autosave", modifiedFiles, removedFiles,
+               removedDirs);  // can throw
+      return true;
+    } catch (const Exception& e) {
+      qCritical() << "Failed to write autosave backup:" << e.getMsg();
+      return false;
+    }
+  });
+  return mAutosaveFuture;
+}
+
 void TransactionalFileSystem::save() {
   QMutexLocker lock(&mMutex);
 
+  // wait for a running autosave since it would write an outdated backup
+  mAutosaveFuture.waitForFinished();
+
   // save to backup directory
   saveDiff("backup");  // can throw
+  ++mSaveCount;
 
   // modifications are now saved to the backup directory, so there is no risk
   // of losing a restored autosave backup, thus we can reset its flag
@@ -379,6 +441,12 @@ void TransactionalFileSystem::save() {
     if (fp.isExistingDir()) {
       FileUtils::removeDirRecursively(fp);  // can throw
     }
+    const QString prefix = cleanPath(dir) % "/";
+    foreach (const QString& filepath, mDiskHashes.keys()) {
+      if (dir.isEmpty() || filepath.startsWith(prefix)) {
+        mDiskHashes.remove(filepath);
+      }
+    }
   }
 
   // remove files
@@ -387,12 +455,14 @@ void TransactionalFileSystem::save() {
     if (fp.isExistingFile()) {
       FileUtils::removeFile(fp);  // can throw
     }
+    mDiskHashes.remove(filepath);
   }
 
   // save new or modified files
   foreach (const QString& filepath, mModifiedFiles.keys()) {
-    FileUtils::writeFile(mFilePath.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+    const QByteArray content = mModifiedFiles.value(filepath);
+    FileUtils::writeFile(mFilePath.getPathTo(filepath), content);  // can throw
+    mDiskHashes.insert(filepath, hashContent(content));
   }
 
   // remove backup
@@ -403,6 +473,7 @@ void TransactionalFileSystem::save() {
 }
 
 void TransactionalFileSystem::releaseLock() {
+  mAutosaveFuture.waitForFinished();
   mIsWritable = false;
   mLock.unlockIfLocked();  // can throw
 }
@@ -437,6 +508,11 @@ bool TransactionalFileSystem::isRemoved(const QString& path) const noexcept {
   return false;
 }
 
+QByteArray TransactionalFileSystem::hashContent(
+    const QByteArray& content) noexcept {
+  return QCryptographicHash::hash(content, QCryptographicHash::Sha256);
+}
+
 void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
                                              const FilePath& zipFp,
                                              const QString& dir,
@@ -482,30 +558,40 @@ void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
 }
 
 void TransactionalFileSystem::saveDiff(const QString& type) const {
-  QDateTime dt = QDateTime::currentDateTime();
-  FilePath dir = mFilePath.getPathTo("." % type);
-  FilePath filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
-
   if (!mIsWritable) {
     throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
   }
 
+  saveDiff(mFilePath, type, mModifiedFiles, mRemovedFiles,
+           mRemovedDirs);  // can throw
+}
+
+void TransactionalFileSystem::saveDiff(
+    const FilePath& basePath, const QString& type,
+    const QHash<QString, QByteArray>& modifiedFiles,
+    const QSet<QString>& removedFiles, const QSet<QString>& removedDirs) {
+  // Note: This method might be called from a different thread, thus it must
+  // not access any member variables!
+  QDateTime dt = QDateTime::currentDateTime();
+  FilePath dir = basePath.getPathTo("." % type);
+  FilePath filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
+
   SExpression root = SExpression::createList("librepcb_" % type);
   root.ensureLineBreak();
   root.appendChild("created", dt);
   root.ensureLineBreak();
   root.appendChild("modified_files_directory", filesDir.getFilename());
-  foreach (const QString& filepath, Toolbox::sorted(mModifiedFiles.keys())) {
+  foreach (const QString& filepath, Toolbox::sorted(modifiedFiles.keys())) {
     root.ensureLineBreak();
     root.appendChild("modified_file", filepath);
     FileUtils::writeFile(filesDir.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+                         modifiedFiles.value(filepath));  // can throw
   }
-  foreach (const QString& filepath, Toolbox::sorted(mRemovedFiles.values())) {
+  foreach (const QString& filepath, Toolbox::sorted(removedFiles.values())) {
     root.ensureLineBreak();
     root.appendChild("removed_file", filepath);
   }
-  foreach (const QString& filepath, Toolbox::sorted(mRemovedDirs.values())) {
+  foreach (const QString& filepath, Toolbox::sorted(removedDirs.values())) {
     root.ensureLineBreak();
     root.appendChild("removed_directory", filepath);
   }
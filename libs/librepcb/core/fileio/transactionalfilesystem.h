@@ -56,10 +56,13 @@ namespace librepcb {
  *  - In R/W mode, it locks the accessed directory to avoid parallel usage (see
  *    @ref doc_project_lock)
  *  - Supports periodic saving to allow restoring the last autosave backup after
- *    an application crash (see @ref doc_project_autosave).
+ *    an application crash (see @ref doc_project_autosave). The backup can
+ *    also be written in a background thread, see #startAutosave().
  *  - Holds all file modifications in memory and allows to write those in an
  *    atomic way to the disk (see @ref doc_project_save).
  *  - Allows to export the whole file system to a ZIP file.
+ *  - Skips writing files whose content is identical to the file on disk, so
+ *    unchanged files are neither backed up nor rewritten when saving.
  *
  * In addition, all public methods of this class are thread-safe, i.e.
  * concurrent access to the file system from multiple threads is allowed.
@@ -179,6 +182,20 @@ public:
   void discardChanges() noexcept;
   QStringList checkForModifications() const;
   void autosave();
+
+  /**
+   * @brief Start writing an autosave backup in a background thread
+   *
+   * The current modifications are copied immediately (which is cheap since
+   * the file contents are implicitly shared), so the file system can be
+   * modified while the backup is written. #save() and the destructor wait
+   * until a running autosave is finished, thus an outdated backup cannot
+   * overwrite or survive a newer save.
+   *
+   * @return Future which reports whether the backup was written successfully.
+   */
+  QFuture<bool> startAutosave();
+
   void save();
   void releaseLock();
 
@@ -208,9 +225,14 @@ public:
 
 private:  // Methods
   bool isRemoved(const QString& path) const noexcept;
+  static QByteArray hashContent(const QByteArray& content) noexcept;
   void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
                       const QString& dir, FilterFunction filter) const;
   void saveDiff(const QString& type) const;
+  static void saveDiff(const FilePath& basePath, const QString& type,
+                       const QHash<QString, QByteArray>& modifiedFiles,
+                       const QSet<QString>& removedFiles,
+                       const QSet<QString>& removedDirs);
   void loadDiff(const FilePath& fp);
   void removeDiff(const QString& type);
 
@@ -220,11 +242,17 @@ private:  // Data
   DirectoryLock mLock;
   bool mRestoredFromAutosave;
   mutable QMutex mMutex;
+  QFuture<bool> mAutosaveFuture;  ///< Autosave running in background
 
   // File system modifications
   QHash<QString, QByteArray> mModifiedFiles;
   QSet<QString> mRemovedFiles;
   QSet<QString> mRemovedDirs;
+
+  /// Content hashes of files as they are on disk (only files which were read
+  /// or saved), used to skip writing files with unchanged content
+  mutable QHash<QString, QByteArray> mDiskHashes;
+  quint64 mSaveCount;  ///< Incremented before #save() modifies the disk
 };
 
 /*******************************************************************************
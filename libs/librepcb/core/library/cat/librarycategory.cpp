@@ -55,6 +55,11 @@ LibraryCategory::LibraryCategory(
 LibraryCategory::~LibraryCategory() noexcept {
 }
 
+LibraryCategory::Metadata::Metadata(const SExpression& root)
+  : LibraryBaseElement::Metadata(root),
+    parent(deserialize<tl::optional<Uuid>>(root.getChild("parent/@0"))) {
+}
+
 /*******************************************************************************
  *  Protected Methods
  ******************************************************************************/
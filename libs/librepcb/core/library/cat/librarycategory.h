@@ -44,6 +44,13 @@ class LibraryCategory : public LibraryBaseElement {
   Q_OBJECT
 
 public:
+  // Types
+  struct Metadata : public LibraryBaseElement::Metadata {
+    tl::optional<Uuid> parent;
+
+    explicit Metadata(const SExpression& root);
+  };
+
   // Constructors / Destructor
   LibraryCategory() = delete;
   LibraryCategory(const LibraryCategory& other) = delete;
@@ -63,6 +63,13 @@ Device::Device(std::unique_ptr<TransactionalDirectory> directory,
 Device::~Device() noexcept {
 }
 
+Device::Metadata::Metadata(const SExpression& root)
+  : LibraryElement::Metadata(root),
+    componentUuid(deserialize<Uuid>(root.getChild("component/@0"))),
+    packageUuid(deserialize<Uuid>(root.getChild("package/@0"))),
+    parts(root) {
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
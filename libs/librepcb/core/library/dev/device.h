@@ -56,6 +56,15 @@ class Device final : public LibraryElement {
   Q_OBJECT
 
 public:
+  // Types
+  struct Metadata : public LibraryElement::Metadata {
+    Uuid componentUuid;
+    Uuid packageUuid;
+    PartList parts;
+
+    explicit Metadata(const SExpression& root);
+  };
+
   // Constructors / Destructor
   Device() = delete;
   Device(const Device& other) = delete;
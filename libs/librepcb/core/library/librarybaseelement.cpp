@@ -24,6 +24,7 @@
 
 #include "../application.h"
 #include "../fileio/versionfile.h"
+#include "../serialization/fileformatmigration.h"
 #include "../serialization/sexpression.h"
 #include "../utils/toolbox.h"
 #include "librarybaseelementcheck.h"
@@ -84,15 +85,20 @@ LibraryBaseElement::LibraryBaseElement(
   }
 
   // Check directory name.
-  const QString dirName = mDirectory->getAbsPath().getFilename();
-  if (dirnameMustBeUuid && (dirName != mUuid.toStr())) {
-    throw RuntimeError(
-        __FILE__, __LINE__,
-        QString("Directory name UUID mismatch: '%1' != '%2'\n\nDirectory: '%3'")
-            .arg(dirName, mUuid.toStr(), mDirectory->getAbsPath().toNative()));
+  if (dirnameMustBeUuid) {
+    checkDirectoryName(*mDirectory, mUuid);  // can throw
   }
 }
 
+LibraryBaseElement::Metadata::Metadata(const SExpression& root)
+  : uuid(deserialize<Uuid>(root.getChild("@0"))),
+    version(deserialize<Version>(root.getChild("version/@0"))),
+    deprecated(deserialize<bool>(root.getChild("deprecated/@0"))),
+    names(root),
+    descriptions(root),
+    keywords(root) {
+}
+
 LibraryBaseElement::~LibraryBaseElement() noexcept {
 }
 
@@ -199,6 +205,31 @@ Version LibraryBaseElement::readFileFormat(
   return fileFormat;
 }
 
+std::unique_ptr<const SExpression> LibraryBaseElement::readMetadataRoot(
+    const TransactionalDirectory& directory, const QString& shortElementName,
+    const QString& longElementName) {
+  const Version fileFormat =
+      readFileFormat(directory, ".librepcb-" % shortElementName);
+  if (!FileFormatMigration::getMigrations(fileFormat).isEmpty()) {
+    return nullptr;
+  }
+  const QString fileName = longElementName % ".lp";
+  return std::unique_ptr<const SExpression>(new SExpression(
+      SExpression::parse(directory.read(fileName),
+                         directory.getAbsPath(fileName))));  // can throw
+}
+
+void LibraryBaseElement::checkDirectoryName(
+    const TransactionalDirectory& directory, const Uuid& uuid) {
+  const QString dirName = directory.getAbsPath().getFilename();
+  if (dirName != uuid.toStr()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        QString("Directory name UUID mismatch: '%1' != '%2'\n\nDirectory: '%3'")
+            .arg(dirName, uuid.toStr(), directory.getAbsPath().toNative()));
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -49,6 +49,27 @@ class LibraryBaseElement : public QObject {
   Q_OBJECT
 
 public:
+  // Types
+
+  /**
+   * @brief The attributes needed to index a library element
+   *
+   * Loading only these attributes with #loadMetadata() is much faster than
+   * opening the whole element since no geometry etc. is deserialized.
+   * Subclasses extend this struct with their own attributes, if needed.
+   */
+  struct Metadata {
+    Uuid uuid;
+    Version version;
+    bool deprecated;
+    LocalizedNameMap names;
+    LocalizedDescriptionMap descriptions;
+    LocalizedKeywordsMap keywords;
+
+    explicit Metadata(const SExpression& root);
+    virtual ~Metadata() noexcept {}
+  };
+
   // Constructors / Destructor
   LibraryBaseElement() = delete;
   LibraryBaseElement(const LibraryBaseElement& other) = delete;
@@ -125,6 +146,31 @@ public:
                           ElementType::getShortElementName());
   }
 
+  /**
+   * @brief Load only the metadata of a library element
+   *
+   * @param directory   Directory of the library element.
+   *
+   * @return The loaded metadata, or `nullptr` if the element needs to be
+   *         upgraded to the current file format first (which is only
+   *         possible by opening the whole element).
+   *
+   * @throw Exception if the element could not be loaded.
+   */
+  template <typename ElementType>
+  static std::unique_ptr<typename ElementType::Metadata> loadMetadata(
+      const TransactionalDirectory& directory) {
+    std::unique_ptr<typename ElementType::Metadata> metadata;
+    const std::unique_ptr<const SExpression> root =
+        readMetadataRoot(directory, ElementType::getShortElementName(),
+                         ElementType::getLongElementName());  // can throw
+    if (root) {
+      metadata.reset(new typename ElementType::Metadata(*root));  // can throw
+      checkDirectoryName(directory, metadata->uuid);  // can throw
+    }
+    return metadata;
+  }
+
 protected:  // Methods
   /**
    * @brief Serialize into ::librepcb::SExpression node
@@ -139,6 +185,11 @@ protected:  // Methods
 
   static Version readFileFormat(const TransactionalDirectory& directory,
                                 const QString& fileName);
+  static std::unique_ptr<const SExpression> readMetadataRoot(
+      const TransactionalDirectory& directory, const QString& shortElementName,
+      const QString& longElementName);
+  static void checkDirectoryName(const TransactionalDirectory& directory,
+                                 const Uuid& uuid);
 
 protected:  // Data
   // General Attributes
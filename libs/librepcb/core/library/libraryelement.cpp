@@ -65,6 +65,13 @@ LibraryElement::LibraryElement(
 LibraryElement::~LibraryElement() noexcept {
 }
 
+LibraryElement::Metadata::Metadata(const SExpression& root)
+  : LibraryBaseElement::Metadata(root), categories() {
+  foreach (const SExpression* node, root.getChildren("category")) {
+    categories.insert(deserialize<Uuid>(node->getChild("@0")));
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
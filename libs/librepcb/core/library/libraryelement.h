@@ -46,6 +46,13 @@ class LibraryElement : public LibraryBaseElement {
   Q_OBJECT
 
 public:
+  // Types
+  struct Metadata : public LibraryBaseElement::Metadata {
+    QSet<Uuid> categories;
+
+    explicit Metadata(const SExpression& root);
+  };
+
   // Constructors / Destructor
   LibraryElement() = delete;
   LibraryElement(const LibraryElement& other) = delete;
@@ -111,6 +111,13 @@ Package::Package(std::unique_ptr<TransactionalDirectory> directory,
 Package::~Package() noexcept {
 }
 
+Package::Metadata::Metadata(const SExpression& root)
+  : LibraryElement::Metadata(root), alternativeNames() {
+  foreach (const SExpression* node, root.getChildren("alternative_name")) {
+    alternativeNames.append(AlternativeName(*node));
+  }
+}
+
 /*******************************************************************************
  *  Getters
  ******************************************************************************/
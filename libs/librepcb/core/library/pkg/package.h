@@ -75,6 +75,11 @@ public:
       root.appendChild("reference", reference);
     }
   };
+  struct Metadata : public LibraryElement::Metadata {
+    QList<AlternativeName> alternativeNames;
+
+    explicit Metadata(const SExpression& root);
+  };
   enum class AssemblyType {
     None,  ///< Nothing to mount (i.e. not a package, just a footprint)
     Tht,  ///< Pure THT package
@@ -43,6 +43,7 @@
 #include "boardairwiresbuilder.h"
 #include "boarddesignrules.h"
 #include "boardfabricationoutputsettings.h"
+#include "drc/boarddesignrulecheckcache.h"
 #include "drc/boarddesignrulechecksettings.h"
 #include "items/bi_airwire.h"
 #include "items/bi_device.h"
@@ -79,8 +80,10 @@ Board::Board(Project& project,
     mDirectoryName(directoryName),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mModified(true),
     mDesignRules(new BoardDesignRules()),
     mDrcSettings(new BoardDesignRuleCheckSettings()),
+    mDrcCache(new BoardDesignRuleCheckCache()),
     mFabricationOutputSettings(new BoardFabricationOutputSettings()),
     mUuid(uuid),
     mName(name),
@@ -106,6 +109,12 @@ Board::Board(Project& project,
   // Emit the "attributesChanged" signal when the project has emitted it.
   connect(&mProject, &Project::attributesChanged, this,
           &Board::attributesChanged);
+
+  // Discard the airwires builder of removed net signals.
+  connect(&mProject.getCircuit(), &Circuit::netSignalRemoved, this,
+          [this](NetSignal& netsignal) {
+            mAirWiresBuilders.remove(&netsignal);
+          });
 }
 
 Board::~Board() noexcept {
@@ -130,6 +139,7 @@ Board::~Board() noexcept {
   mDeviceInstances.clear();
 
   mFabricationOutputSettings.reset();
+  mDrcCache.reset();
   mDrcSettings.reset();
   mDesignRules.reset();
 }
@@ -272,6 +282,7 @@ std::shared_ptr<SceneData3D> Board::buildScene3D(
 void Board::setInnerLayerCount(int count) noexcept {
   if (count != mInnerLayerCount) {
     mInnerLayerCount = count;
+    mModified = true;
     mCopperLayers.clear();
     mCopperLayers.insert(&Layer::topCopper());
     mCopperLayers.insert(&Layer::botCopper());
@@ -288,6 +299,7 @@ void Board::setInnerLayerCount(int count) noexcept {
 void Board::setDesignRules(const BoardDesignRules& rules) noexcept {
   if (rules != *mDesignRules) {
     *mDesignRules = rules;
+    mModified = true;
     invalidatePlanes();
     emit designRulesModified();
     emit attributesChanged();
@@ -297,6 +309,13 @@ void Board::setDesignRules(const BoardDesignRules& rules) noexcept {
 void Board::setDrcSettings(
     const BoardDesignRuleCheckSettings& settings) noexcept {
   *mDrcSettings = settings;
+  mModified = true;
+}
+
+void Board::setFabricationOutputSettings(
+    const BoardFabricationOutputSettings& settings) noexcept {
+  *mFabricationOutputSettings = settings;
+  mModified = true;
 }
 
 /*******************************************************************************
@@ -307,6 +326,7 @@ void Board::loadDrcMessageApprovals(
     const Version& version, const QSet<SExpression>& approvals) noexcept {
   mDrcMessageApprovalsVersion = version;
   mDrcMessageApprovals = approvals;
+  mModified = true;
 }
 
 bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
@@ -325,6 +345,7 @@ bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
   if (mDrcMessageApprovalsVersion < Application::getFileFormatVersion()) {
     mDrcMessageApprovalsVersion = Application::getFileFormatVersion();
     mDrcMessageApprovals &= approvals;
+    mModified = true;
     return true;
   }
 
@@ -334,6 +355,7 @@ bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
       mDrcMessageApprovals - (mSupportedDrcMessageApprovals - approvals);
   if (approvals != mDrcMessageApprovals) {
     mDrcMessageApprovals = approvals;
+    mModified = true;
     return true;
   }
 
@@ -347,6 +369,7 @@ void Board::setDrcMessageApproved(const SExpression& approval,
   } else {
     mDrcMessageApprovals.remove(approval);
   }
+  mModified = true;
 }
 
 /*******************************************************************************
@@ -373,6 +396,7 @@ void Board::addDeviceInstance(BI_Device& instance) {
     instance.addToBoard();  // can throw
   }
   mDeviceInstances.insert(instance.getComponentInstanceUuid(), &instance);
+  mModified = true;
   emit deviceAdded(instance);
 }
 
@@ -385,6 +409,7 @@ void Board::removeDeviceInstance(BI_Device& instance) {
     instance.removeFromBoard();  // can throw
   }
   mDeviceInstances.remove(instance.getComponentInstanceUuid());
+  mModified = true;
   emit deviceRemoved(instance);
 }
 
@@ -407,6 +432,7 @@ void Board::addNetSegment(BI_NetSegment& netsegment) {
     netsegment.addToBoard();  // can throw
   }
   mNetSegments.insert(netsegment.getUuid(), &netsegment);
+  mModified = true;
   emit netSegmentAdded(netsegment);
 }
 
@@ -418,6 +444,7 @@ void Board::removeNetSegment(BI_NetSegment& netsegment) {
     netsegment.removeFromBoard();  // can throw
   }
   mNetSegments.remove(netsegment.getUuid());
+  mModified = true;
   emit netSegmentRemoved(netsegment);
 }
 
@@ -438,6 +465,7 @@ void Board::addPlane(BI_Plane& plane) {
     plane.addToBoard();  // can throw
   }
   mPlanes.insert(plane.getUuid(), &plane);
+  mModified = true;
   emit planeAdded(plane);
 }
 
@@ -449,6 +477,7 @@ void Board::removePlane(BI_Plane& plane) {
     plane.removeFromBoard();  // can throw
   }
   mPlanes.remove(plane.getUuid());
+  mModified = true;
   emit planeRemoved(plane);
 }
 
@@ -494,6 +523,7 @@ void Board::addZone(BI_Zone& zone) {
     zone.addToBoard();  // can throw
   }
   mZones.insert(zone.getData().getUuid(), &zone);
+  mModified = true;
   emit zoneAdded(zone);
 }
 
@@ -505,6 +535,7 @@ void Board::removeZone(BI_Zone& zone) {
     zone.removeFromBoard();  // can throw
   }
   mZones.remove(zone.getData().getUuid());
+  mModified = true;
   emit zoneRemoved(zone);
 }
 
@@ -527,6 +558,7 @@ void Board::addPolygon(BI_Polygon& polygon) {
     polygon.addToBoard();  // can throw
   }
   mPolygons.insert(polygon.getData().getUuid(), &polygon);
+  mModified = true;
   emit polygonAdded(polygon);
 }
 
@@ -538,6 +570,7 @@ void Board::removePolygon(BI_Polygon& polygon) {
     polygon.removeFromBoard();  // can throw
   }
   mPolygons.remove(polygon.getData().getUuid());
+  mModified = true;
   emit polygonRemoved(polygon);
 }
 
@@ -559,6 +592,7 @@ void Board::addStrokeText(BI_StrokeText& text) {
     text.addToBoard();  // can throw
   }
   mStrokeTexts.insert(text.getData().getUuid(), &text);
+  mModified = true;
   emit strokeTextAdded(text);
 }
 
@@ -570,6 +604,7 @@ void Board::removeStrokeText(BI_StrokeText& text) {
     text.removeFromBoard();  // can throw
   }
   mStrokeTexts.remove(text.getData().getUuid());
+  mModified = true;
   emit strokeTextRemoved(text);
 }
 
@@ -590,6 +625,7 @@ void Board::addHole(BI_Hole& hole) {
     hole.addToBoard();  // can throw
   }
   mHoles.insert(hole.getData().getUuid(), &hole);
+  mModified = true;
   emit holeAdded(hole);
 }
 
@@ -601,6 +637,7 @@ void Board::removeHole(BI_Hole& hole) {
     hole.removeFromBoard();  // can throw
   }
   mHoles.remove(hole.getData().getUuid());
+  mModified = true;
   emit holeRemoved(hole);
 }
 
@@ -615,27 +652,48 @@ void Board::triggerAirWiresRebuild() noexcept {
 
   try {
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
-      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
+      // calculate new airwires
+      QVector<BoardAirWiresBuilder::AirWire> airwires;
+      if (netsignal && netsignal->isAddedToCircuit()) {
+        std::shared_ptr<BoardAirWiresBuilder>& builder =
+            mAirWiresBuilders[netsignal];
+        if (!builder) {
+          builder.reset(new BoardAirWiresBuilder(*this, *netsignal));
+        }
+        airwires = builder->buildAirWires();  // can throw
+      } else {
+        mAirWiresBuilders.remove(netsignal);
+      }
+
+      // Remove old airwires, except those which are still valid. This avoids
+      // recreating the airwires (and their graphics items) of large nets when
+      // only a few anchors have been modified.
+      QSet<BoardAirWiresBuilder::AirWire> newAirWires;
+      foreach (const auto& points, airwires) {
+        newAirWires.insert(std::minmax(points.first, points.second));
+      }
+      foreach (BI_AirWire* airWire, mAirWires.values(netsignal)) {
+        const BoardAirWiresBuilder::AirWire points =
+            std::minmax(&airWire->getP1(), &airWire->getP2());
+        auto it = newAirWires.find(points);
+        if ((it != newAirWires.end()) &&
+            airWire->connects(*it->first, *it->second)) {
+          newAirWires.erase(it);
+          continue;  // Keep this airwire.
+        }
+        mAirWires.remove(netsignal, airWire);
         airWire->removeFromBoard();  // can throw
         emit airWireRemoved(*airWire);
         delete airWire;
       }
 
-      if (netsignal && netsignal->isAddedToCircuit()) {
-        // calculate new airwires
-        BoardAirWiresBuilder builder(*this, *netsignal);
-        QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
-            airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, *points.first, *points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.data());
-          emit airWireAdded(*airWire.take());
-        }
+      // add new airwires
+      foreach (const auto& points, newAirWires) {
+        QScopedPointer<BI_AirWire> airWire(
+            new BI_AirWire(*this, *netsignal, *points.first, *points.second));
+        airWire->addToBoard();  // can throw
+        mAirWires.insertMulti(netsignal, airWire.data());
+        emit airWireAdded(*airWire.take());
       }
     }
     mScheduledNetSignalsForAirWireRebuild.clear();
@@ -715,7 +773,7 @@ void Board::copyFrom(const Board& other) {
   mSilkscreenLayersTop = other.mSilkscreenLayersTop;
   mSilkscreenLayersBot = other.mSilkscreenLayersBot;
   *mDesignRules = other.getDesignRules();
-  *mFabricationOutputSettings = other.getFabricationOutputSettings();
+  setFabricationOutputSettings(other.getFabricationOutputSettings());
 
   // Copy device instances.
   QHash<const BI_Device*, BI_Device*> devMap;
@@ -856,6 +914,7 @@ void Board::addToProject() {
   }
 
   mIsAddedToProject = true;
+  mModified = true;
   forceAirWiresRebuild();
   sgl.dismiss();
 }
@@ -882,8 +941,9 @@ void Board::removeFromProject() {
 }
 
 void Board::save() {
-  // Content.
-  {
+  // Content. Not serialized again if nothing was modified since it was
+  // written to the transactional directory the last time.
+  if (mModified) {
     SExpression root = SExpression::createList("librepcb_board");
     root.appendChild(mUuid);
     root.ensureLineBreak();
@@ -972,6 +1032,7 @@ void Board::save() {
     }
     root.ensureLineBreak();
     mDirectory->write("board.lp", root.toByteArray());
+    mModified = false;
   }
 
   // User settings.
@@ -53,6 +53,8 @@ class BI_Polygon;
 class BI_StrokeText;
 class BI_Via;
 class BI_Zone;
+class BoardAirWiresBuilder;
+class BoardDesignRuleCheckCache;
 class BoardDesignRuleCheckSettings;
 class BoardDesignRules;
 class BoardFabricationOutputSettings;
@@ -92,14 +94,13 @@ public:
   const BoardDesignRuleCheckSettings& getDrcSettings() const noexcept {
     return *mDrcSettings;
   }
-  BoardFabricationOutputSettings& getFabricationOutputSettings() noexcept {
-    return *mFabricationOutputSettings;
-  }
+  BoardDesignRuleCheckCache& getDrcCache() noexcept { return *mDrcCache; }
   const BoardFabricationOutputSettings& getFabricationOutputSettings()
       const noexcept {
     return *mFabricationOutputSettings;
   }
   bool isEmpty() const noexcept;
+  bool isModified() const noexcept { return mModified; }
   QList<BI_Base*> getAllItems() const noexcept;
   std::shared_ptr<SceneData3D> buildScene3D(
       const tl::optional<Uuid>& assemblyVariant) const noexcept;
@@ -142,29 +143,50 @@ public:
   }
 
   // Setters
-  void setName(const ElementName& name) noexcept { mName = name; }
+  void setName(const ElementName& name) noexcept {
+    mName = name;
+    mModified = true;
+  }
   void setDefaultFontName(const QString& name) noexcept {
     mDefaultFontFileName = name;
+    mModified = true;
   }
   void setGridInterval(const PositiveLength& interval) noexcept {
     mGridInterval = interval;
+    mModified = true;
+  }
+  void setGridUnit(const LengthUnit& unit) noexcept {
+    mGridUnit = unit;
+    mModified = true;
   }
-  void setGridUnit(const LengthUnit& unit) noexcept { mGridUnit = unit; }
   void setInnerLayerCount(int count) noexcept;
-  void setPcbThickness(const PositiveLength& t) noexcept { mPcbThickness = t; }
-  void setSolderResist(const PcbColor* c) noexcept { mSolderResist = c; }
-  void setSilkscreenColor(const PcbColor& c) noexcept { mSilkscreenColor = &c; }
+  void setPcbThickness(const PositiveLength& t) noexcept {
+    mPcbThickness = t;
+    mModified = true;
+  }
+  void setSolderResist(const PcbColor* c) noexcept {
+    mSolderResist = c;
+    mModified = true;
+  }
+  void setSilkscreenColor(const PcbColor& c) noexcept {
+    mSilkscreenColor = &c;
+    mModified = true;
+  }
   void setSilkscreenLayersTop(const QVector<const Layer*>& l) noexcept {
     mSilkscreenLayersTop = l;
+    mModified = true;
   }
   void setSilkscreenLayersBot(const QVector<const Layer*>& l) noexcept {
     mSilkscreenLayersBot = l;
+    mModified = true;
   }
   void setLayersVisibility(const QMap<QString, bool>& visibility) noexcept {
     mLayersVisibility = visibility;
   }
   void setDesignRules(const BoardDesignRules& rules) noexcept;
   void setDrcSettings(const BoardDesignRuleCheckSettings& settings) noexcept;
+  void setFabricationOutputSettings(
+      const BoardFabricationOutputSettings& settings) noexcept;
 
   // DRC Message Approval Methods
   const QSet<SExpression>& getDrcMessageApprovals() const noexcept {
@@ -241,6 +263,15 @@ public:
   void removeFromProject();
   void save();
 
+  /**
+   * @brief Mark the board as modified since the last #save()
+   *
+   * Must be called on every modification of the board file content, since
+   * #save() does not serialize unmodified boards again. The user settings are
+   * always written since they are not tracked.
+   */
+  void setModified() noexcept { mModified = true; }
+
   // Operator Overloadings
   Board& operator=(const Board& rhs) = delete;
   bool operator==(const Board& rhs) noexcept { return (this == &rhs); }
@@ -274,9 +305,11 @@ private:
   const QString mDirectoryName;
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool mIsAddedToProject;
+  bool mModified;  ///< Whether the board file needs to be written on #save()
 
   QScopedPointer<BoardDesignRules> mDesignRules;
   QScopedPointer<BoardDesignRuleCheckSettings> mDrcSettings;
+  QScopedPointer<BoardDesignRuleCheckCache> mDrcCache;
   QScopedPointer<BoardFabricationOutputSettings> mFabricationOutputSettings;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
   QSet<const Layer*> mScheduledLayersForPlanesRebuild;
@@ -314,6 +347,9 @@ private:
   QMap<Uuid, BI_StrokeText*> mStrokeTexts;
   QMap<Uuid, BI_Hole*> mHoles;
   QMultiHash<NetSignal*, BI_AirWire*> mAirWires;
+
+  /// Persistent airwire builders for incremental airwire updates
+  QHash<NetSignal*, std::shared_ptr<BoardAirWiresBuilder>> mAirWiresBuilders;
 };
 
 /*******************************************************************************
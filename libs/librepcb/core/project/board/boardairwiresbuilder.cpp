@@ -22,7 +22,6 @@
  ******************************************************************************/
 #include "boardairwiresbuilder.h"
 
-#include "../../algorithm/airwiresbuilder.h"
 #include "../../library/pkg/footprintpad.h"
 #include "../../types/layer.h"
 #include "../circuit/circuit.h"
@@ -39,6 +38,8 @@
 
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -60,33 +61,45 @@ BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
  *  General Methods
  ******************************************************************************/
 
-QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
-    BoardAirWiresBuilder::buildAirWires() const {
-  AirWiresBuilder builder;
-
-  // Map from ID to (position, start layer number, end layer number)
-  QHash<int, std::tuple<Point, int, int>> pointLayerMap;
+QVector<BoardAirWiresBuilder::AirWire> BoardAirWiresBuilder::buildAirWires() {
+  // All anchors with their position, start layer number and end layer number.
+  QVector<const BI_NetLineAnchor*> anchors;
+  QVector<Point> positions;
+  QVector<std::pair<int, int>> layers;
 
   // Map from anchor to ID
   QHash<const BI_NetLineAnchor*, int> anchorMap;
 
+  // Union-find structure to determine the clusters of connected anchors
+  QVector<int> parents;
+  auto addAnchor = [&](const BI_NetLineAnchor* anchor, const Point& pos,
+                       int startLayer, int endLayer) {
+    const int id = anchors.count();
+    anchors.append(anchor);
+    positions.append(pos);
+    layers.append(std::make_pair(startLayer, endLayer));
+    parents.append(id);
+    anchorMap[anchor] = id;
+  };
+  auto unite = [&parents](int id1, int id2) {
+    const int cluster1 = findCluster(parents, id1);
+    const int cluster2 = findCluster(parents, id2);
+    parents[std::max(cluster1, cluster2)] = std::min(cluster1, cluster2);
+  };
+
   // pads
   foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
     Q_ASSERT(cmpSig);
     foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
       if (&pad->getBoard() != &mBoard) continue;
-      const Point& pos = pad->getPosition();
-      int id = builder.addPoint(pos);
       if (pad->getLibPad().isTht()) {
-        pointLayerMap[id] =
-            std::make_tuple(pos, Layer::topCopper().getCopperNumber(),
-                            Layer::botCopper().getCopperNumber());
+        addAnchor(pad, pad->getPosition(), Layer::topCopper().getCopperNumber(),
+                  Layer::botCopper().getCopperNumber());
       } else {
-        pointLayerMap[id] =
-            std::make_tuple(pos, pad->getSmtLayer().getCopperNumber(),
-                            pad->getSmtLayer().getCopperNumber());
+        addAnchor(pad, pad->getPosition(),
+                  pad->getSmtLayer().getCopperNumber(),
+                  pad->getSmtLayer().getCopperNumber());
       }
-      anchorMap[pad] = id;
     }
   }
 
@@ -96,61 +109,99 @@ QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
     if (&netsegment->getBoard() != &mBoard) continue;
     foreach (const BI_Via* via, netsegment->getVias()) {
       Q_ASSERT(via);
-      const Point& pos = via->getPosition();
-      int id = builder.addPoint(pos);
-      pointLayerMap[id] =
-          std::make_tuple(pos, via->getVia().getStartLayer().getCopperNumber(),
-                          via->getVia().getEndLayer().getCopperNumber());
-      anchorMap[via] = id;
+      addAnchor(via, via->getPosition(),
+                via->getVia().getStartLayer().getCopperNumber(),
+                via->getVia().getEndLayer().getCopperNumber());
     }
     foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
       Q_ASSERT(netpoint);
       if (const Layer* layer = netpoint->getLayerOfTraces()) {
-        Point pos = netpoint->getPosition();
-        int id = builder.addPoint(pos);
-        pointLayerMap[id] = std::make_tuple(pos, layer->getCopperNumber(),
-                                            layer->getCopperNumber());
-        anchorMap[netpoint] = id;
+        addAnchor(netpoint, netpoint->getPosition(), layer->getCopperNumber(),
+                  layer->getCopperNumber());
       }
     }
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       Q_ASSERT(netline);
       Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
       Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      builder.addEdge(anchorMap[&netline->getStartPoint()],
-                      anchorMap[&netline->getEndPoint()]);
+      unite(anchorMap[&netline->getStartPoint()],
+              anchorMap[&netline->getEndPoint()]);
     }
   }
 
   // determine connections made by planes
+  QHash<const BI_Plane*, PlaneCache> planeCache;
   foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
     Q_ASSERT(plane);
     if (&plane->getBoard() != &mBoard) continue;
+    PlaneCache& cache = planeCache[plane];
+    cache = mPlaneCache.value(plane);
+    if (cache.fragments != plane->getFragments()) {
+      // Plane has been rebuilt, cached results are outdated.
+      cache = PlaneCache{plane->getFragments(), {}};
+    }
     const int planeLayer = plane->getLayer().getCopperNumber();
-    foreach (const Path& fragment, plane->getFragments()) {
-      int lastId = -1;
-      for (auto it = pointLayerMap.begin(); it != pointLayerMap.end(); it++) {
-        const Point& pos = std::get<0>(it.value());
-        const int startLayer = std::get<1>(it.value());
-        const int endLayer = std::get<2>(it.value());
-        if ((planeLayer >= startLayer) && (planeLayer <= endLayer) &&
-            fragment.toQPainterPathPx().contains(pos.toPxQPointF())) {
-          if (lastId >= 0) {
-            builder.addEdge(lastId, it.key());
+    QVector<int> fragmentAnchors(plane->getFragments().count(), -1);
+    for (int id = 0; id < anchors.count(); ++id) {
+      if ((planeLayer >= layers.at(id).first) &&
+          (planeLayer <= layers.at(id).second)) {
+        foreach (int i, getFragmentsAtPos(*plane, cache, positions.at(id))) {
+          if (fragmentAnchors.at(i) >= 0) {
+            unite(fragmentAnchors.at(i), id);
           }
-          lastId = it.key();
+          fragmentAnchors[i] = id;
         }
       }
     }
   }
+  mPlaneCache = planeCache;  // Discard cache of removed planes.
+
+  // Each cluster is identified by its lowest anchor ID.
+  QVector<int> clusters(anchors.count());
+  for (int id = 0; id < anchors.count(); ++id) {
+    clusters[id] = findCluster(parents, id);
+  }
+
+  // Determine the clusters containing anchors which have been moved since the
+  // last call. Added or removed anchors change the clusters as well.
+  QSet<int> movedClusters;
+  int movedAnchors = 0;
+  if (clusters == mLastClusters) {
+    for (int id = 0; id < anchors.count(); ++id) {
+      if (positions.at(id) != mLastPositions.at(id)) {
+        movedClusters.insert(clusters.at(id));
+        ++movedAnchors;
+      }
+    }
+  }
 
-  // Calculate the airwires and convert them back to the result type.
-  const AirWiresBuilder::AirWires airWireIds = builder.buildAirWires();
-  QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>> result;
-  result.reserve(airWireIds.size());
-  foreach (const AirWiresBuilder::AirWire& airWire, airWireIds) {
-    const BI_NetLineAnchor* p1 = anchorMap.key(airWire.first, nullptr);
-    const BI_NetLineAnchor* p2 = anchorMap.key(airWire.second, nullptr);
+  // Calculate the airwires only if the input has been modified. If only a few
+  // anchors have been moved (e.g. the pads of a dragged footprint), just the
+  // clusters of these anchors are linked again to the rest of the net. Since
+  // each moved anchor is compared with all other anchors, many moved anchors
+  // are faster handled by a full rebuild.
+  if ((clusters != mLastClusters) || (movedAnchors * 8 > anchors.count())) {
+    mLastAirWires = calcAirWires(positions, clusters, QSet<int>());
+    mMovedClusters.clear();
+    mUnmovedAirWires.clear();
+  } else if (movedAnchors > 0) {
+    // The airwires between the unmoved clusters stay valid as long as the
+    // same clusters are moved, which is the case while dragging.
+    if (movedClusters != mMovedClusters) {
+      mUnmovedAirWires = calcAirWires(positions, clusters, movedClusters);
+      mMovedClusters = movedClusters;
+    }
+    mLastAirWires = linkClusters(positions, clusters, movedClusters);
+  }
+  mLastPositions = positions;
+  mLastClusters = clusters;
+
+  // Convert the airwires back to the result type.
+  QVector<AirWire> result;
+  result.reserve(mLastAirWires.size());
+  foreach (const AirWiresBuilder::AirWire& airWire, mLastAirWires) {
+    const BI_NetLineAnchor* p1 = anchors.value(airWire.first, nullptr);
+    const BI_NetLineAnchor* p2 = anchors.value(airWire.second, nullptr);
     if ((!p1) || (!p2)) {
       throw LogicError(__FILE__, __LINE__, "Unknown air wire IDs received.");
     }
@@ -160,6 +211,113 @@ QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
   return result;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+AirWiresBuilder::AirWires BoardAirWiresBuilder::calcAirWires(
+    const QVector<Point>& positions, const QVector<int>& clusters,
+    const QSet<int>& excludedClusters) noexcept {
+  AirWiresBuilder builder;
+  QVector<int> anchorIds;  // Map from builder point ID to anchor ID
+  QHash<int, int> pointIds;  // Map from anchor ID to builder point ID
+  for (int id = 0; id < positions.count(); ++id) {
+    if (!excludedClusters.contains(clusters.at(id))) {
+      pointIds[id] = builder.addPoint(positions.at(id));
+      anchorIds.append(id);
+    }
+  }
+  foreach (int id, anchorIds) {
+    if (clusters.at(id) != id) {
+      builder.addEdge(pointIds.value(clusters.at(id)), pointIds.value(id));
+    }
+  }
+  AirWiresBuilder::AirWires airWires = builder.buildAirWires();
+  for (AirWiresBuilder::AirWire& airWire : airWires) {
+    airWire.first = anchorIds.at(airWire.first);
+    airWire.second = anchorIds.at(airWire.second);
+  }
+  return airWires;
+}
+
+AirWiresBuilder::AirWires BoardAirWiresBuilder::linkClusters(
+    const QVector<Point>& positions, const QVector<int>& clusters,
+    const QSet<int>& movedClusters) const noexcept {
+  auto getWeight = [&positions](int id1, int id2) {
+    const qreal dx = (positions.at(id1) - positions.at(id2)).getX().toNm();
+    const qreal dy = (positions.at(id1) - positions.at(id2)).getY().toNm();
+    return dx * dx + dy * dy;
+  };
+
+  // The shortest connection between each moved cluster and any other cluster.
+  // Together with the airwires between the unmoved clusters, these candidates
+  // contain all airwires of the minimum spanning tree.
+  typedef std::pair<qreal, AirWiresBuilder::AirWire> Candidate;
+  QHash<QPair<int, int>, Candidate> shortestConnections;
+  for (int id1 = 0; id1 < positions.count(); ++id1) {
+    const int cluster1 = clusters.at(id1);
+    if (!movedClusters.contains(cluster1)) continue;
+    for (int id2 = 0; id2 < positions.count(); ++id2) {
+      const int cluster2 = clusters.at(id2);
+      if (cluster2 == cluster1) continue;
+      const Candidate candidate(getWeight(id1, id2),
+                                std::make_pair(std::min(id1, id2),
+                                               std::max(id1, id2)));
+      const QPair<int, int> key(std::min(cluster1, cluster2),
+                                std::max(cluster1, cluster2));
+      auto it = shortestConnections.find(key);
+      if (it == shortestConnections.end()) {
+        shortestConnections.insert(key, candidate);
+      } else if (candidate < *it) {
+        *it = candidate;
+      }
+    }
+  }
+  QVector<Candidate> candidates = shortestConnections.values().toVector();
+  foreach (const AirWiresBuilder::AirWire& airWire, mUnmovedAirWires) {
+    candidates.append(
+        Candidate(getWeight(airWire.first, airWire.second), airWire));
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  // Kruskal's algorithm on the clusters.
+  QVector<int> parents = clusters;
+  AirWiresBuilder::AirWires airWires;
+  foreach (const Candidate& candidate, candidates) {
+    const int cluster1 = findCluster(parents, candidate.second.first);
+    const int cluster2 = findCluster(parents, candidate.second.second);
+    if (cluster1 != cluster2) {
+      parents[std::max(cluster1, cluster2)] = std::min(cluster1, cluster2);
+      airWires.append(candidate.second);
+    }
+  }
+  return airWires;
+}
+
+const QVector<int>& BoardAirWiresBuilder::getFragmentsAtPos(
+    const BI_Plane& plane, PlaneCache& cache, const Point& pos) noexcept {
+  auto it = cache.fragmentsAtPos.find(pos);
+  if (it == cache.fragmentsAtPos.end()) {
+    QVector<int> fragments;
+    for (int i = 0; i < plane.getFragments().count(); ++i) {
+      if (plane.isInFragment(i, pos)) {
+        fragments.append(i);
+      }
+    }
+    it = cache.fragmentsAtPos.insert(pos, fragments);
+  }
+  return *it;
+}
+
+int BoardAirWiresBuilder::findCluster(QVector<int>& parents,
+                                      int index) noexcept {
+  while (parents.at(index) != index) {
+    parents[index] = parents.at(parents.at(index));  // Path halving.
+    index = parents.at(index);
+  }
+  return index;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
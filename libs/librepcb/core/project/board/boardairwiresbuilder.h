@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../algorithm/airwiresbuilder.h"
+#include "../../geometry/path.h"
 #include "../../types/point.h"
 
 #include <QtCore>
@@ -33,6 +35,7 @@
 namespace librepcb {
 
 class BI_NetLineAnchor;
+class BI_Plane;
 class Board;
 class NetSignal;
 
@@ -41,10 +44,27 @@ class NetSignal;
  ******************************************************************************/
 
 /**
- * @brief The BoardAirWiresBuilder class
+ * @brief Builds the airwires of a ::librepcb::NetSignal within a
+ *        ::librepcb::Board
+ *
+ * An instance is intended to be kept for the whole lifetime of a net to allow
+ * incremental updates: The anchors of the net are grouped into connected
+ * clusters (by net lines and plane fragments) with a union-find structure,
+ * where the expensive point-in-plane-fragment checks are cached per anchor
+ * position. If neither the anchor positions nor the clusters have changed
+ * since the last call of #buildAirWires(), the previous result is returned
+ * without running the triangulation and MST again. If only a few anchors have
+ * been moved (e.g. the pads of a dragged footprint), the airwires between the
+ * unmoved clusters are kept and only the clusters of the moved anchors are
+ * linked again to the rest of the net. The airwires between the unmoved
+ * clusters are calculated once when a different set of clusters starts to
+ * move, so subsequent drag steps don't run the triangulation at all.
  */
 class BoardAirWiresBuilder final {
 public:
+  // Types
+  typedef std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*> AirWire;
+
   // Constructors / Destructor
   BoardAirWiresBuilder() = delete;
   BoardAirWiresBuilder(const BoardAirWiresBuilder& other) = delete;
@@ -52,15 +72,40 @@ public:
   ~BoardAirWiresBuilder() noexcept;
 
   // General Methods
-  QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
-      buildAirWires() const;
+  QVector<AirWire> buildAirWires();
 
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
 
+private:  // Types
+  struct PlaneCache {
+    QVector<Path> fragments;  ///< Fragments the cache is valid for
+    QHash<Point, QVector<int>> fragmentsAtPos;  ///< Fragment indices
+  };
+
+private:  // Methods
+  static AirWiresBuilder::AirWires calcAirWires(
+      const QVector<Point>& positions, const QVector<int>& clusters,
+      const QSet<int>& excludedClusters) noexcept;
+  AirWiresBuilder::AirWires linkClusters(
+      const QVector<Point>& positions, const QVector<int>& clusters,
+      const QSet<int>& movedClusters) const noexcept;
+  const QVector<int>& getFragmentsAtPos(const BI_Plane& plane,
+                                        PlaneCache& cache,
+                                        const Point& pos) noexcept;
+  static int findCluster(QVector<int>& parents, int index) noexcept;
+
 private:  // Data
   const Board& mBoard;
   const NetSignal& mNetSignal;
+
+  // Cached data
+  QHash<const BI_Plane*, PlaneCache> mPlaneCache;
+  QVector<Point> mLastPositions;
+  QVector<int> mLastClusters;
+  AirWiresBuilder::AirWires mLastAirWires;
+  QSet<int> mMovedClusters;  ///< Clusters excluded from mUnmovedAirWires
+  AirWiresBuilder::AirWires mUnmovedAirWires;  ///< Between unmoved clusters
 };
 
 /*******************************************************************************
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boardplanefragmentsbuilder.h"
 
+#include "../../algorithm/spatialindex.h"
 #include "../../library/pkg/footprint.h"
 #include "../../library/pkg/footprintpad.h"
 #include "../../utils/clipperhelpers.h"
@@ -45,6 +46,7 @@
 #include <QtCore>
 
 #include <algorithm>
+#include <exception>
 
 /*******************************************************************************
  *  Namespace
@@ -61,10 +63,19 @@ BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(bool rebuildAirWires,
     mRebuildAirWires(rebuildAirWires),
     mFuture(),
     mWatcher(),
-    mAbort(false) {
+    mAbort(false),
+    mSuspended(false),
+    mResultPending(false) {
   connect(
       &mWatcher, &QFutureWatcherBase::finished, this,
-      [this]() { applyToBoard(mFuture.result()); }, Qt::QueuedConnection);
+      [this]() {
+        if (mSuspended) {
+          mResultPending = true;
+        } else {
+          applyToBoard(mFuture.result());
+        }
+      },
+      Qt::QueuedConnection);
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
@@ -88,6 +99,9 @@ void BoardPlaneFragmentsBuilder::runSynchronously(
 
 bool BoardPlaneFragmentsBuilder::startAsynchronously(
     Board& board, const QSet<const Layer*>* layers) noexcept {
+  if (mSuspended) {
+    return false;
+  }
   if (auto data = createJob(board, layers)) {
     cancel();
     mFuture =
@@ -110,10 +124,54 @@ void BoardPlaneFragmentsBuilder::cancel() noexcept {
   mAbort = false;
 }
 
+void BoardPlaneFragmentsBuilder::setSuspended(bool suspended) noexcept {
+  mSuspended = suspended;
+  if ((!mSuspended) && mResultPending) {
+    mResultPending = false;
+    applyToBoard(mFuture.result());
+  }
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+bool BoardPlaneFragmentsBuilder::PlaneData::operator==(
+    const PlaneData& rhs) const noexcept {
+  return (uuid == rhs.uuid) && (layer == rhs.layer) &&
+      (netSignal == rhs.netSignal) && (outline == rhs.outline) &&
+      (minWidth == rhs.minWidth) && (minClearance == rhs.minClearance) &&
+      (keepIslands == rhs.keepIslands) && (priority == rhs.priority) &&
+      (connectStyle == rhs.connectStyle) && (thermalGap == rhs.thermalGap) &&
+      (thermalSpokeWidth == rhs.thermalSpokeWidth);
+}
+
+bool BoardPlaneFragmentsBuilder::KeepoutZoneData::operator==(
+    const KeepoutZoneData& rhs) const noexcept {
+  return (transform == rhs.transform) && (layers == rhs.layers) &&
+      (boardLayers == rhs.boardLayers) && (outline == rhs.outline);
+}
+
+bool BoardPlaneFragmentsBuilder::PolygonData::operator==(
+    const PolygonData& rhs) const noexcept {
+  return (transform == rhs.transform) && (layer == rhs.layer) &&
+      (netSignal == rhs.netSignal) && (path == rhs.path) &&
+      (width == rhs.width) && (filled == rhs.filled);
+}
+
+bool BoardPlaneFragmentsBuilder::ViaData::operator==(
+    const ViaData& rhs) const noexcept {
+  return (netSignal == rhs.netSignal) && (position == rhs.position) &&
+      (diameter == rhs.diameter) && (startLayer == rhs.startLayer) &&
+      (endLayer == rhs.endLayer);
+}
+
+bool BoardPlaneFragmentsBuilder::PadData::operator==(
+    const PadData& rhs) const noexcept {
+  return (transform == rhs.transform) && (netSignal == rhs.netSignal) &&
+      (clearance == rhs.clearance) && (geometries == rhs.geometries);
+}
+
 std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
     BoardPlaneFragmentsBuilder::createJob(
         Board& board, const QSet<const Layer*>* filter) noexcept {
@@ -137,6 +195,12 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
   auto data = std::make_shared<JobData>();
   data->board = &board;
   data->layers = layers;
+  foreach (const Layer* layer, data->layers) {
+    std::shared_ptr<const JobData> previous = mLastJobs.value(layer);
+    if (previous && (previous->board == data->board)) {
+      data->previousJobs.insert(layer, previous);
+    }
+  }
   layers.insert(&Layer::boardOutlines());
   layers.insert(&Layer::boardCutouts());
   foreach (const BI_Device* device, board.getDeviceInstances()) {
@@ -304,12 +368,64 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       boardCutouts.append(polygon.path);
     }
   }
-  ClipperLib::Paths boardArea =
-      ClipperHelpers::convert(boardOutlines, maxArcTolerance());
+  data->boardArea = ClipperHelpers::convert(boardOutlines, maxArcTolerance());
   ClipperHelpers::subtract(
-      boardArea, ClipperHelpers::convert(boardCutouts, maxArcTolerance()),
+      data->boardArea, ClipperHelpers::convert(boardCutouts, maxArcTolerance()),
       ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 
+  // Determine the bounding boxes of all objects to skip objects which are far
+  // away from a plane before doing any expensive Clipper operations.
+  PathsCache cache;
+  foreach (const KeepoutZoneData& zone, data->keepoutZones) {
+    data->keepoutZonePaths.append(
+        ClipperHelpers::convert(zone.outline, maxArcTolerance()));
+    data->keepoutZoneBounds.append(
+        SpatialIndex::getBounds(data->keepoutZonePaths.last()));
+  }
+  foreach (const PolygonData& polygon, data->polygons) {
+    data->polygonPaths.append(
+        ClipperHelpers::convert(polygon.path, maxArcTolerance()));
+    data->polygonBounds.append(
+        SpatialIndex::grown(SpatialIndex::getBounds(data->polygonPaths.last()),
+                            std::max(*polygon.width, Length(1)).toNm() / 2));
+  }
+  foreach (const auto& tuple, data->holes) {
+    data->holeBounds.append(SpatialIndex::grown(
+        SpatialIndex::getBounds(
+            ClipperHelpers::convert(*std::get<2>(tuple), maxArcTolerance())),
+        std::get<1>(tuple)->toNm() / 2));
+  }
+  foreach (const ViaData& via, data->vias) {
+    const ClipperLib::IntPoint center = ClipperHelpers::convert(via.position);
+    const ClipperLib::cInt radius = via.diameter->toNm() / 2;
+    data->viaBounds.append(
+        ClipperLib::IntRect{center.X - radius, center.Y - radius,
+                            center.X + radius, center.Y + radius});
+  }
+  for (const PadData& pad : qAsConst(data->pads)) {
+    ClipperLib::IntRect bounds = SpatialIndex::emptyRect();
+    for (auto it = pad.geometries.begin(); it != pad.geometries.end(); it++) {
+      if (!data->layers.contains(it.key())) {
+        continue;
+      }
+      for (const PadGeometry& geometry : it.value()) {
+        const ClipperLib::Paths& outlines =
+            cache.getPadOutlines(pad, geometry, 0);
+        bounds =
+            SpatialIndex::united(bounds, SpatialIndex::getBounds(outlines));
+        for (const PadHole& hole : geometry.getHoles()) {
+          const ClipperLib::Path path = ClipperHelpers::convert(
+              pad.transform.map(*hole.getPath()), maxArcTolerance());
+          bounds = SpatialIndex::united(
+              bounds,
+              SpatialIndex::grown(SpatialIndex::getBounds(path),
+                                  hole.getDiameter()->toNm() / 2));
+        }
+      }
+    }
+    data->padBounds.append(bounds);
+  }
+
   // Sort planes: First by priority, then by uuid to get a really unique
   // priority order over all existing planes. This way we can ensure that even
   // planes with the same priority will always be filled in the same order.
@@ -323,14 +439,108 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
               }
             });
 
-  // Build all planes.
-  for (auto it = data->planes.begin(); it != data->planes.end(); it++) {
+  // Build all planes. Planes on different layers never affect each other, so
+  // the planes of each layer are built concurrently.
+  QVector<const Layer*> planeLayers;
+  QHash<const Layer*, QList<PlaneData>> planesPerLayer;
+  foreach (const PlaneData& plane, data->planes) {
+    if (!planesPerLayer.contains(plane.layer)) {
+      planeLayers.append(plane.layer);
+    }
+    planesPerLayer[plane.layer].append(plane);
+  }
+  QVector<QFuture<QHash<Uuid, QVector<Path>>>> futures;
+  foreach (const Layer* layer, planeLayers) {
+    const QList<PlaneData> planes = planesPerLayer.value(layer);
+    futures.append(
+        QtConcurrent::run([this, data, layer, planes, cache,
+                           exceptionOnError]() {
+          return buildPlanes(*data, layer, planes, cache,
+                             exceptionOnError);  // can throw
+        }));
+  }
+
+  // Collect the results. If any layer failed, wait until all other layers are
+  // finished since they still access the job data.
+  std::exception_ptr error;
+  for (QFuture<QHash<Uuid, QVector<Path>>>& future : futures) {
+    try {
+      const QHash<Uuid, QVector<Path>> result = future.result();  // can throw
+      for (auto it = result.begin(); it != result.end(); it++) {
+        data->result.insert(it.key(), it.value());
+      }
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  data->previousJobs.clear();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  if (mAbort) {
+    qDebug() << "Aborted calculating plane areas after" << timer.elapsed()
+             << "ms.";
+  } else {
+    data->finished = true;
+    qDebug() << "Calculated plane areas in" << timer.elapsed() << "ms.";
+  }
+
+  emit finished();
+  return data;
+}
+
+QHash<Uuid, QVector<Path>> BoardPlaneFragmentsBuilder::buildPlanes(
+    const JobData& data, const Layer* layer, const QList<PlaneData>& planes,
+    PathsCache cache, bool exceptionOnError) {
+  // Note: This method is called from a different thread, thus be careful with
+  //       calling other methods to only call thread-safe methods!
+  // Note: All planes must be on the same layer and sorted by priority.
+
+  // Determine the areas modified since the previous job. Planes not touching
+  // any of these areas keep their previous fragments.
+  std::shared_ptr<const JobData> previous = data.previousJobs.value(layer);
+  if (previous && (previous->boardArea != data.boardArea)) {
+    previous.reset();
+  }
+  QVector<ClipperLib::IntRect> modifiedAreas;
+  if (previous) {
+    modifiedAreas = determineModifiedAreas(*previous, data, layer);
+  }
+
+  QHash<Uuid, QVector<Path>> result;
+  QHash<Uuid, ClipperLib::IntRect> planeBounds;
+  for (auto it = planes.begin(); it != planes.end(); it++) {
     try {
+      // Reuse the previous fragments if neither the plane itself nor anything
+      // around it has been modified. Planes which failed to build have no
+      // previous result, so they are always built again.
+      if (previous && previous->result.contains(it->uuid) &&
+          previous->planes.contains(*it)) {
+        const Length margin = std::max(*it->minClearance, *it->thermalGap) +
+            *it->minWidth + *maxArcTolerance();
+        const ClipperLib::IntRect area = SpatialIndex::grown(
+            SpatialIndex::getBounds(ClipperHelpers::convert(
+                it->outline.toClosedPath(), maxArcTolerance())),
+            margin.toNm());
+        auto isModified = [&area](const ClipperLib::IntRect& modifiedArea) {
+          return SpatialIndex::intersects(modifiedArea, area);
+        };
+        if (std::none_of(modifiedAreas.begin(), modifiedAreas.end(),
+                         isModified)) {
+          result[it->uuid] = previous->result.value(it->uuid);
+          planeBounds[it->uuid] = getBounds(result[it->uuid]);
+          continue;
+        }
+      }
+
       ClipperLib::Paths removedAreas;
       ClipperLib::Paths connectedNetSignalAreas;
 
       // Start with board outline shrinked by the given clearance.
-      ClipperLib::Paths fragments = boardArea;
+      ClipperLib::Paths fragments = data.boardArea;
       ClipperHelpers::offset(fragments, -it->minClearance,
                              maxArcTolerance());  // can throw
       if (mAbort) {
@@ -348,16 +558,35 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
         break;
       }
 
+      // Objects outside of the plane area (including their clearance) do not
+      // have any effect on the plane, so they are skipped.
+      const ClipperLib::IntRect fullPlaneBounds =
+          SpatialIndex::getBounds(fullPlaneArea);
+      auto isNearPlane = [&fullPlaneBounds](const ClipperLib::IntRect& bounds,
+                                            const Length& clearance) {
+        const Length margin = clearance + *maxArcTolerance();
+        return SpatialIndex::intersects(
+            SpatialIndex::grown(bounds, margin.toNm()), fullPlaneBounds);
+      };
+
       // Collect other planes.
-      for (auto otherIt = data->planes.begin(); otherIt != it; otherIt++) {
-        if ((otherIt->layer == it->layer) &&
-            (otherIt->netSignal != it->netSignal)) {
+      for (auto otherIt = planes.begin(); otherIt != it; otherIt++) {
+        if (otherIt->netSignal != it->netSignal) {
           const UnsignedLength clearance =
               std::max(it->minClearance, otherIt->minClearance);
-          ClipperLib::Paths clipperPaths = ClipperHelpers::convert(
-              data->result.value(otherIt->uuid), maxArcTolerance());
-          ClipperHelpers::offset(clipperPaths, *clearance,
-                                 maxArcTolerance());  // can throw
+          if (!isNearPlane(
+                  planeBounds.value(otherIt->uuid, SpatialIndex::emptyRect()),
+                  *clearance)) {
+            continue;
+          }
+          const ClipperLib::Paths& clipperPaths = cache.get(
+              &(*otherIt), nullptr, PathsCache::Type::Area, *clearance, [&]() {
+                ClipperLib::Paths paths = ClipperHelpers::convert(
+                    result.value(otherIt->uuid), maxArcTolerance());
+                ClipperHelpers::offset(paths, *clearance,
+                                       maxArcTolerance());  // can throw
+                return paths;
+              });
           removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
                               clipperPaths.end());
         }
@@ -367,22 +596,28 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
 
       // Collect keepout zones.
-      foreach (const KeepoutZoneData& zone, data->keepoutZones) {
-        if (zone.boardLayers.contains(it->layer)) {
-          const ClipperLib::Path clipperPath =
-              ClipperHelpers::convert(zone.outline, maxArcTolerance());
-          removedAreas.push_back(clipperPath);
+      for (int i = 0; i < data.keepoutZones.count(); ++i) {
+        if (data.keepoutZones.at(i).boardLayers.contains(it->layer) &&
+            isNearPlane(data.keepoutZoneBounds.at(i), Length(0))) {
+          removedAreas.push_back(data.keepoutZonePaths.at(i));
         }
       }
 
       // Collect holes.
-      foreach (const auto& tuple, data->holes) {
-        const PositiveLength diameter(std::get<1>(tuple) +
-                                      it->minClearance * 2);
-        const QVector<Path> paths =
-            std::get<2>(tuple)->toOutlineStrokes(diameter);
-        const ClipperLib::Paths clipperPaths =
-            ClipperHelpers::convert(paths, maxArcTolerance());
+      for (int i = 0; i < data.holes.count(); ++i) {
+        if (!isNearPlane(data.holeBounds.at(i), *it->minClearance)) {
+          continue;
+        }
+        const auto& tuple = data.holes.at(i);
+        const ClipperLib::Paths& clipperPaths = cache.get(
+            &tuple, nullptr, PathsCache::Type::Strokes, *it->minClearance,
+            [&]() {
+              const PositiveLength diameter(std::get<1>(tuple) +
+                                            it->minClearance * 2);
+              const QVector<Path> paths =
+                  std::get<2>(tuple)->toOutlineStrokes(diameter);
+              return ClipperHelpers::convert(paths, maxArcTolerance());
+            });
         removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
                             clipperPaths.end());
       }
@@ -391,29 +626,38 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
 
       // Collect vias.
-      foreach (const ViaData& via, data->vias) {
+      for (int i = 0; i < data.vias.count(); ++i) {
+        const ViaData& via = data.vias.at(i);
         if ((via.startLayer->getCopperNumber() >
              it->layer->getCopperNumber()) ||
             (via.endLayer->getCopperNumber() < it->layer->getCopperNumber())) {
           continue;
         }
-        if (it->netSignal && (via.netSignal == it->netSignal)) {
+        if (!isNearPlane(data.viaBounds.at(i), *it->minClearance)) {
+          continue;
+        }
+        // Note: The connected area is the same as a cut-out without
+        // clearance, thus both are cached with their clearance as key.
+        const bool sameNet = it->netSignal && (via.netSignal == it->netSignal);
+        const Length clearance = sameNet ? Length(0) : *it->minClearance;
+        const ClipperLib::Paths& clipperPaths = cache.get(
+            &via, nullptr, PathsCache::Type::Area, clearance, [&]() {
+              const Path path =
+                  Path::circle(PositiveLength(via.diameter + clearance * 2))
+                      .translated(via.position);
+              return ClipperLib::Paths{
+                  ClipperHelpers::convert(path, maxArcTolerance())};
+            });
+        if (sameNet) {
           // Via has same net as plane -> no cut-out.
           // Note: Do not respect the plane connect style for vias, but always
           // connect them with solid style. Since vias are not soldered, heat
           // dissipation is not an issue or often even desired. See discussion
           // https://github.com/LibrePCB/LibrePCB/issues/454#issuecomment-1373402172
-          const Path path = Path::circle(via.diameter).translated(via.position);
-          connectedNetSignalAreas.push_back(
-              ClipperHelpers::convert(path, maxArcTolerance()));
+          connectedNetSignalAreas.push_back(clipperPaths.front());
         } else {
           // Vias has different net than plane -> subtract with clearance.
-          const Path path =
-              Path::circle(PositiveLength(via.diameter + it->minClearance * 2))
-                  .translated(via.position);
-          const ClipperLib::Path clipperPath =
-              ClipperHelpers::convert(path, maxArcTolerance());
-          removedAreas.push_back(clipperPath);
+          removedAreas.push_back(clipperPaths.front());
         }
       }
       if (mAbort) {
@@ -421,49 +665,46 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
 
       // Collect traces & other strokes.
-      foreach (const PolygonData& polygon, data->polygons) {
-        if (polygon.layer == it->layer) {
-          if (it->netSignal && (polygon.netSignal == it->netSignal)) {
+      for (int i = 0; i < data.polygons.count(); ++i) {
+        const PolygonData& polygon = data.polygons.at(i);
+        if ((polygon.layer != it->layer) ||
+            (!isNearPlane(data.polygonBounds.at(i), *it->minClearance))) {
+          continue;
+        }
+        const bool sameNet =
+            it->netSignal && (polygon.netSignal == it->netSignal);
+        const Length clearance = sameNet ? Length(0) : *it->minClearance;
+        ClipperLib::Paths& areas =
+            sameNet ? connectedNetSignalAreas : removedAreas;
+        if (polygon.filled) {
+          // Area.
+          if (sameNet) {
             // Same net signal -> memorize as connected area.
-            if (polygon.filled) {
-              // Area.
-              const ClipperLib::Path clipperPath =
-                  ClipperHelpers::convert(polygon.path, maxArcTolerance());
-              connectedNetSignalAreas.push_back(clipperPath);
-            }
-            if ((!polygon.filled) || (polygon.width > 0)) {
-              // Outline strokes.
-              const QVector<Path> paths = polygon.path.toOutlineStrokes(
-                  PositiveLength(std::max(*polygon.width, Length(1))));
-              const ClipperLib::Paths clipperPaths =
-                  ClipperHelpers::convert(paths, maxArcTolerance());
-              connectedNetSignalAreas.insert(connectedNetSignalAreas.end(),
-                                             clipperPaths.begin(),
-                                             clipperPaths.end());
-            }
+            connectedNetSignalAreas.push_back(data.polygonPaths.at(i));
           } else {
             // Different net signal -> subtract with clearance.
-            if (polygon.filled) {
-              // Area.
-              ClipperLib::Paths clipperPaths{
-                  ClipperHelpers::convert(polygon.path, maxArcTolerance())};
-              ClipperHelpers::offset(clipperPaths, *it->minClearance,
-                                     maxArcTolerance());  // can throw
-              removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                  clipperPaths.end());
-            }
-            if ((!polygon.filled) || (polygon.width > 0)) {
-              // Outline strokes.
-              const QVector<Path> paths =
-                  polygon.path.toOutlineStrokes(PositiveLength(std::max(
-                      *polygon.width + it->minClearance * 2, Length(1))));
-              const ClipperLib::Paths clipperPaths =
-                  ClipperHelpers::convert(paths, maxArcTolerance());
-              removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                  clipperPaths.end());
-            }
+            const ClipperLib::Paths& clipperPaths = cache.get(
+                &polygon, nullptr, PathsCache::Type::Area, clearance, [&]() {
+                  ClipperLib::Paths paths{data.polygonPaths.at(i)};
+                  ClipperHelpers::offset(paths, clearance,
+                                         maxArcTolerance());  // can throw
+                  return paths;
+                });
+            removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
+                                clipperPaths.end());
           }
         }
+        if ((!polygon.filled) || (polygon.width > 0)) {
+          // Outline strokes.
+          const ClipperLib::Paths& clipperPaths = cache.get(
+              &polygon, nullptr, PathsCache::Type::Strokes, clearance, [&]() {
+                const QVector<Path> paths =
+                    polygon.path.toOutlineStrokes(PositiveLength(
+                        std::max(*polygon.width + clearance * 2, Length(1))));
+                return ClipperHelpers::convert(paths, maxArcTolerance());
+              });
+          areas.insert(areas.end(), clipperPaths.begin(), clipperPaths.end());
+        }
       }
       if (mAbort) {
         break;
@@ -473,15 +714,24 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       ClipperLib::Paths thermalPadAreas;
       ClipperLib::Paths thermalPadAreasShrinked;
       ClipperLib::Paths thermalPadClearanceAreas;
-      foreach (const PadData& pad, data->pads) {
+      for (int i = 0; i < data.pads.count(); ++i) {
+        const PadData& pad = data.pads.at(i);
+        const auto geometriesIt = pad.geometries.constFind(it->layer);
+        if (geometriesIt == pad.geometries.constEnd()) {
+          continue;
+        }
+        const Length maxClearance =
+            std::max({*it->minClearance, *it->thermalGap, *pad.clearance}) +
+            *it->minWidth;
+        if (!isNearPlane(data.padBounds.at(i), maxClearance)) {
+          continue;
+        }
         const bool sameNet = it->netSignal && (pad.netSignal == it->netSignal);
-        foreach (const PadGeometry& geometry, pad.geometries.value(it->layer)) {
+        for (const PadGeometry& geometry : geometriesIt.value()) {
           if (sameNet) {
             // Same net signal -> memorize as connected area.
-            const QVector<Path> paths =
-                pad.transform.map(geometry.toOutlines());
-            const ClipperLib::Paths clipperPaths =
-                ClipperHelpers::convert(paths, maxArcTolerance());
+            const ClipperLib::Paths& clipperPaths =
+                cache.getPadOutlines(pad, geometry, 0);
             connectedNetSignalAreas.insert(connectedNetSignalAreas.end(),
                                            clipperPaths.begin(),
                                            clipperPaths.end());
@@ -494,10 +744,8 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
             // plane area.
             const Length clearance = std::max(
                 sameNet ? *it->thermalGap : *it->minClearance, *pad.clearance);
-            QVector<Path> paths =
-                pad.transform.map(geometry.withOffset(clearance).toOutlines());
             ClipperLib::Paths clipperPaths =
-                ClipperHelpers::convert(paths, maxArcTolerance());
+                cache.getPadOutlines(pad, geometry, clearance);
 
             // For thermal relief connection, subtract the spokes from the
             // cutout.
@@ -526,8 +774,7 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
               }
               // Memorize copper area for later removal of unconnected
               // thermal spokes,
-              ClipperLib::Paths tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.toOutlines()), maxArcTolerance());
+              ClipperLib::Paths tmp = cache.getPadOutlines(pad, geometry, 0);
               if (tmp.size() > 1) {
                 ClipperHelpers::unite(tmp,
                                       ClipperLib::pftNonZero);  // can throw
@@ -537,9 +784,7 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
               // Memorize clearance area for later removal of unconnected
               // thermal spokes,
               Length offset = clearance + it->minWidth - maxArcTolerance() - 10;
-              tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.withOffset(offset).toOutlines()),
-                  maxArcTolerance());
+              tmp = cache.getPadOutlines(pad, geometry, offset);
               if (tmp.size() > 1) {
                 ClipperHelpers::unite(tmp,
                                       ClipperLib::pftNonZero);  // can throw
@@ -549,11 +794,10 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
               // Memorize slightly shrinked copper area for later removal of
               // unconnected thermal spokes,
               offset = -maxArcTolerance() - 10;
-              tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.withOffset(offset).toOutlines()),
-                  maxArcTolerance());
+              const ClipperLib::Paths& shrinked =
+                  cache.getPadOutlines(pad, geometry, offset);
               thermalPadAreasShrinked.insert(thermalPadAreasShrinked.end(),
-                                             tmp.begin(), tmp.end());
+                                             shrinked.begin(), shrinked.end());
             }
             removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
                                 clipperPaths.end());
@@ -562,14 +806,17 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
             // even if the pad outline is too small or invalid.
             if (!sameNet) {
               for (const PadHole& hole : geometry.getHoles()) {
-                const PositiveLength width(hole.getDiameter() +
-                                           (clearance * 2));
-                paths =
-                    pad.transform.map(hole.getPath()->toOutlineStrokes(width));
-                clipperPaths =
-                    ClipperHelpers::convert(paths, maxArcTolerance());
-                removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                    clipperPaths.end());
+                const ClipperLib::Paths& holePaths = cache.get(
+                    &pad, &hole, PathsCache::Type::Strokes, clearance, [&]() {
+                      const PositiveLength width(hole.getDiameter() +
+                                                 (clearance * 2));
+                      return ClipperHelpers::convert(
+                          pad.transform.map(
+                              hole.getPath()->toOutlineStrokes(width)),
+                          maxArcTolerance());
+                    });
+                removedAreas.insert(removedAreas.end(), holePaths.begin(),
+                                    holePaths.end());
               }
             }
           }
@@ -691,27 +938,34 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
         break;
       }
 
-      // Memorize fragments for this plane.
-      data->result[it->uuid] = ClipperHelpers::convert(fragments);
+      // Memorize fragments for this plane. If they have been modified, the
+      // planes with lower priority around it need to be rebuilt as well.
+      result[it->uuid] = ClipperHelpers::convert(fragments);
+      planeBounds[it->uuid] = SpatialIndex::getBounds(fragments);
+      if (previous &&
+          (result[it->uuid] != previous->result.value(it->uuid))) {
+        const ClipperLib::IntRect area =
+            SpatialIndex::united(planeBounds[it->uuid],
+                                 getBounds(previous->result.value(it->uuid)));
+        modifiedAreas.append(
+            SpatialIndex::grown(area, it->minClearance->toNm()));
+      }
     } catch (const Exception& e) {
       qCritical() << "Failed to calculate plane areas, leaving empty:"
                   << e.getMsg();
+      result.remove(it->uuid);
+      planeBounds.remove(it->uuid);
+      if (previous) {
+        modifiedAreas.append(
+            SpatialIndex::grown(getBounds(previous->result.value(it->uuid)),
+                                it->minClearance->toNm()));
+      }
       if (exceptionOnError) {
         throw;
       }
     }
   }
-
-  if (mAbort) {
-    qDebug() << "Aborted calculating plane areas after" << timer.elapsed()
-             << "ms.";
-  } else {
-    data->finished = true;
-    qDebug() << "Calculated plane areas in" << timer.elapsed() << "ms.";
-  }
-
-  emit finished();
-  return data;
+  return result;
 }
 
 QVector<std::pair<Point, Angle>>
@@ -781,9 +1035,147 @@ QVector<std::pair<Point, Angle>>
   return {};
 }
 
+template <typename T, typename F>
+void BoardPlaneFragmentsBuilder::addModifiedAreas(
+    const QList<T>& oldItems, const QVector<ClipperLib::IntRect>& oldBounds,
+    const QList<T>& newItems, const QVector<ClipperLib::IntRect>& newBounds,
+    F getArea, QVector<ClipperLib::IntRect>& areas) noexcept {
+  // Items are looked up by their bounding box to avoid comparing every old
+  // item with every new item.
+  auto hashRect = [](const ClipperLib::IntRect& r) {
+    return qHash(r.left, qHash(r.top, qHash(r.right, qHash(r.bottom))));
+  };
+  auto addArea = [&areas](const ClipperLib::IntRect& area) {
+    if (!SpatialIndex::isEmpty(area)) {
+      areas.append(area);
+    }
+  };
+  QMultiHash<uint, int> unmatchedOldItems;
+  for (int i = 0; i < oldItems.count(); ++i) {
+    unmatchedOldItems.insert(hashRect(oldBounds.at(i)), i);
+  }
+  for (int i = 0; i < newItems.count(); ++i) {
+    const uint hash = hashRect(newBounds.at(i));
+    bool found = false;
+    for (auto it = unmatchedOldItems.find(hash);
+         (it != unmatchedOldItems.end()) && (it.key() == hash); it++) {
+      if (oldItems.at(it.value()) == newItems.at(i)) {
+        unmatchedOldItems.erase(it);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      addArea(getArea(newItems.at(i), newBounds.at(i)));
+    }
+  }
+  foreach (int i, unmatchedOldItems) {
+    addArea(getArea(oldItems.at(i), oldBounds.at(i)));
+  }
+}
+
+QVector<ClipperLib::IntRect> BoardPlaneFragmentsBuilder::determineModifiedAreas(
+    const JobData& previous, const JobData& current,
+    const Layer* layer) noexcept {
+  typedef ClipperLib::IntRect Rect;
+  QVector<Rect> areas;
+  addModifiedAreas(previous.keepoutZones, previous.keepoutZoneBounds,
+                   current.keepoutZones, current.keepoutZoneBounds,
+                   [layer](const KeepoutZoneData& zone, const Rect& bounds) {
+                     return zone.boardLayers.contains(layer)
+                         ? bounds
+                         : SpatialIndex::emptyRect();
+                   },
+                   areas);
+  addModifiedAreas(previous.polygons, previous.polygonBounds, current.polygons,
+                   current.polygonBounds,
+                   [layer](const PolygonData& polygon, const Rect& bounds) {
+                     return (polygon.layer == layer)
+                         ? bounds
+                         : SpatialIndex::emptyRect();
+                   },
+                   areas);
+  addModifiedAreas(
+      previous.holes, previous.holeBounds, current.holes, current.holeBounds,
+      [](const std::tuple<Transform, PositiveLength, NonEmptyPath>& hole,
+         const Rect& bounds) {
+        Q_UNUSED(hole);
+        return bounds;
+      },
+      areas);
+  addModifiedAreas(previous.vias, previous.viaBounds, current.vias,
+                   current.viaBounds,
+                   [layer](const ViaData& via, const Rect& bounds) {
+                     const int number = layer->getCopperNumber();
+                     return ((via.startLayer->getCopperNumber() <= number) &&
+                             (via.endLayer->getCopperNumber() >= number))
+                         ? bounds
+                         : SpatialIndex::emptyRect();
+                   },
+                   areas);
+  addModifiedAreas(
+      previous.pads, previous.padBounds, current.pads, current.padBounds,
+      [layer](const PadData& pad, const Rect& bounds) {
+        return pad.geometries.contains(layer)
+            ? SpatialIndex::grown(bounds, pad.clearance->toNm())
+            : SpatialIndex::emptyRect();
+      },
+      areas);
+  foreach (const PlaneData& plane, previous.planes) {
+    if ((plane.layer == layer) && (!current.planes.contains(plane))) {
+      const QVector<Path> fragments = previous.result.value(plane.uuid);
+      areas.append(SpatialIndex::grown(getBounds(fragments),
+                                       plane.minClearance->toNm()));
+    }
+  }
+  return areas;
+}
+
+ClipperLib::IntRect BoardPlaneFragmentsBuilder::getBounds(
+    const QVector<Path>& fragments) noexcept {
+  return SpatialIndex::getBounds(
+      ClipperHelpers::convert(fragments, maxArcTolerance()));
+}
+
+const ClipperLib::Paths& BoardPlaneFragmentsBuilder::PathsCache::get(
+    const void* object, const void* subObject, Type type, const Length& offset,
+    const std::function<ClipperLib::Paths()>& calculator) {
+  const Key key = qMakePair(qMakePair(object, subObject),
+                            qMakePair(static_cast<int>(type), offset));
+  auto it = mPaths.find(key);
+  if (it == mPaths.end()) {
+    it = mPaths.insert(key, calculator());  // can throw
+  }
+  return *it;
+}
+
+const ClipperLib::Paths&
+    BoardPlaneFragmentsBuilder::PathsCache::getPadOutlines(
+        const PadData& pad, const PadGeometry& geometry,
+        const Length& offset) {
+  return get(&pad, &geometry, Type::Outlines, offset, [&]() {
+    return ClipperHelpers::convert(
+        pad.transform.map(geometry.withOffset(offset).toOutlines()),
+        maxArcTolerance());
+  });
+}
+
 bool BoardPlaneFragmentsBuilder::applyToBoard(
     std::shared_ptr<JobData> data) noexcept {
   if (data->board) {
+    if (data->finished) {
+      // Memorize the job to rebuild only modified areas next time.
+      for (auto it = mLastJobs.begin(); it != mLastJobs.end();) {
+        if ((*it)->board != data->board) {
+          it = mLastJobs.erase(it);
+        } else {
+          it++;
+        }
+      }
+      foreach (const Layer* layer, data->layers) {
+        mLastJobs.insert(layer, data);
+      }
+    }
     bool modified = false;
     for (auto it = data->result.begin(); it != data->result.end(); it++) {
       if (BI_Plane* plane = data->board->getPlanes().value(it.key())) {
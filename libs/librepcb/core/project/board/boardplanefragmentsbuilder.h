@@ -29,8 +29,11 @@
 #include "../../utils/transform.h"
 #include "items/bi_plane.h"
 
+#include <polyclipping/clipper.hpp>
+
 #include <QtCore>
 
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -49,6 +52,10 @@ class PadGeometry;
 
 /**
  * @brief Plane fragments builder working on a ::librepcb::Board
+ *
+ * The builder remembers the last finished job of each layer. On subsequent
+ * builds of the same board, only planes located in areas modified since then
+ * are recalculated while all other planes keep their fragments.
  */
 class BoardPlaneFragmentsBuilder final : public QObject {
   Q_OBJECT
@@ -89,8 +96,8 @@ public:
    *                but slower).
    *
    * @retval true   If the build started.
-   * @retval false  If none of the planes need a rebuild, thus did not start
-   *                a rebuild.
+   * @retval false  If none of the planes need a rebuild or the builder is
+   *                suspended, thus did not start a rebuild.
    */
   bool startAsynchronously(Board& board,
                            const QSet<const Layer*>* layers = nullptr) noexcept;
@@ -108,6 +115,17 @@ public:
    */
   void cancel() noexcept;
 
+  /**
+   * @brief Suspend or resume modifying the board
+   *
+   * While suspended, no new asynchronous job is started and the result of a
+   * finished job is not applied to the board before getting resumed. This
+   * allows other threads to safely read the board in the meantime.
+   *
+   * @param suspended   Whether to suspend or resume.
+   */
+  void setSuspended(bool suspended) noexcept;
+
   // Operator Overloadings
   BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) =
       delete;
@@ -130,6 +148,8 @@ private:  // Methods
     BI_Plane::ConnectStyle connectStyle;
     PositiveLength thermalGap;
     PositiveLength thermalSpokeWidth;
+
+    bool operator==(const PlaneData& rhs) const noexcept;
   };
 
   struct KeepoutZoneData {
@@ -137,6 +157,8 @@ private:  // Methods
     Zone::Layers layers;  // Converted to boardLayers after preprocessing.
     QSet<const Layer*> boardLayers;
     Path outline;
+
+    bool operator==(const KeepoutZoneData& rhs) const noexcept;
   };
 
   struct PolygonData {
@@ -146,6 +168,8 @@ private:  // Methods
     Path path;
     UnsignedLength width;
     bool filled;
+
+    bool operator==(const PolygonData& rhs) const noexcept;
   };
 
   struct ViaData {
@@ -154,6 +178,8 @@ private:  // Methods
     PositiveLength diameter;
     const Layer* startLayer;
     const Layer* endLayer;
+
+    bool operator==(const ViaData& rhs) const noexcept;
   };
 
   struct PadData {
@@ -161,6 +187,8 @@ private:  // Methods
     tl::optional<Uuid> netSignal;
     UnsignedLength clearance;
     QHash<const Layer*, QList<PadGeometry>> geometries;
+
+    bool operator==(const PadData& rhs) const noexcept;
   };
 
   struct TraceData {
@@ -183,12 +211,64 @@ private:  // Methods
     QList<TraceData> traces;  // Converted to polygons after preprocessing.
     QHash<Uuid, QVector<Path>> result;
     bool finished = false;
+
+    // The last finished jobs of the same board, used to determine which
+    // areas have been modified since then. Released when the job finished.
+    QHash<const Layer*, std::shared_ptr<const JobData>> previousJobs;
+
+    // Determined during preprocessing.
+    ClipperLib::Paths boardArea;
+    QVector<ClipperLib::Path> keepoutZonePaths;
+    QVector<ClipperLib::IntRect> keepoutZoneBounds;
+    QVector<ClipperLib::Path> polygonPaths;
+    QVector<ClipperLib::IntRect> polygonBounds;
+    QVector<ClipperLib::IntRect> holeBounds;
+    QVector<ClipperLib::IntRect> viaBounds;
+    QVector<ClipperLib::IntRect> padBounds;
+  };
+
+  /**
+   * Converted (and offset) Clipper paths of the job objects. Many planes use
+   * the same clearance values, so the paths of each object are calculated
+   * only once and then shared between all planes of a layer. Since layers are
+   * built concurrently, each of them works on its own copy of the cache.
+   */
+  class PathsCache final {
+  public:
+    enum class Type { Area, Strokes, Outlines };
+    const ClipperLib::Paths& get(
+        const void* object, const void* subObject, Type type,
+        const Length& offset,
+        const std::function<ClipperLib::Paths()>& calculator);
+    const ClipperLib::Paths& getPadOutlines(const PadData& pad,
+                                            const PadGeometry& geometry,
+                                            const Length& offset);
+
+  private:
+    typedef QPair<QPair<const void*, const void*>, QPair<int, Length>> Key;
+    QHash<Key, ClipperLib::Paths> mPaths;
   };
 
   std::shared_ptr<JobData> createJob(Board& board,
                                      const QSet<const Layer*>* filter) noexcept;
   std::shared_ptr<JobData> run(std::shared_ptr<JobData> data,
                                bool exceptionOnError);
+  QHash<Uuid, QVector<Path>> buildPlanes(const JobData& data,
+                                         const Layer* layer,
+                                         const QList<PlaneData>& planes,
+                                         PathsCache cache,
+                                         bool exceptionOnError);
+  static QVector<ClipperLib::IntRect> determineModifiedAreas(
+      const JobData& previous, const JobData& current,
+      const Layer* layer) noexcept;
+  template <typename T, typename F>
+  static void addModifiedAreas(const QList<T>& oldItems,
+                               const QVector<ClipperLib::IntRect>& oldBounds,
+                               const QList<T>& newItems,
+                               const QVector<ClipperLib::IntRect>& newBounds,
+                               F getArea,
+                               QVector<ClipperLib::IntRect>& areas) noexcept;
+  static ClipperLib::IntRect getBounds(const QVector<Path>& fragments) noexcept;
   static QVector<std::pair<Point, Angle>> determineThermalSpokes(
       const PadGeometry& geometry) noexcept;
   bool applyToBoard(std::shared_ptr<JobData> data) noexcept;
@@ -207,6 +287,11 @@ private:  // Data
   QFuture<std::shared_ptr<JobData>> mFuture;
   QFutureWatcher<std::shared_ptr<JobData>> mWatcher;
   bool mAbort;
+  bool mSuspended;
+  bool mResultPending;  ///< Result not applied yet due to #mSuspended
+
+  /// The last finished job of each layer, to rebuild only modified areas
+  QHash<const Layer*, std::shared_ptr<const JobData>> mLastJobs;
 };
 
 /*******************************************************************************
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boarddesignrulecheck.h"
 
+#include "../../../algorithm/spatialindex.h"
 #include "../../../geometry/hole.h"
 #include "../../../geometry/stroketext.h"
 #include "../../../library/cmp/component.h"
@@ -51,9 +52,13 @@
 #include "../items/bi_via.h"
 #include "../items/bi_zone.h"
 #include "boardclipperpathgenerator.h"
+#include "boarddesignrulecheckcache.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
+#include <exception>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -70,9 +75,12 @@ BoardDesignRuleCheck::BoardDesignRuleCheck(
     mBoard(board),
     mSettings(settings),
     mIgnorePlanes(false),
+    mParallel(false),
+    mWorkersRunning(false),
     mProgressPercent(0),
     mProgressStatus(),
-    mMessages() {
+    mMessages(),
+    mCachedPaths(new CopperPathsCache()) {
 }
 
 BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
@@ -82,44 +90,59 @@ BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
  *  General Methods
  ******************************************************************************/
 
-void BoardDesignRuleCheck::execute(bool quick) {
+void BoardDesignRuleCheck::execute(bool quick, bool parallel) {
   emit started();
   emitProgress(2);
 
   mIgnorePlanes = quick;
+  mParallel = parallel;
   mProgressStatus.clear();
   mMessages.clear();
+  mCachedPaths.reset(new CopperPathsCache());
 
   if (!quick) {
     rebuildPlanes(12);  // 10%
   }
 
-  checkMinimumCopperWidth(14);  // 2%
-  checkCopperCopperClearances(24);  // 10%
-  checkCopperBoardClearances(34);  // 10%
-  checkCopperHoleClearances(44);  // 10%
+  typedef BoardDesignRuleCheck DRC;
+  QVector<Check> checks = {
+      {&DRC::checkMinimumCopperWidth, 14, true},  // 2%
+      {&DRC::checkCopperCopperClearances, 24, true},  // 10%
+      {&DRC::checkCopperBoardClearances, 34, true},  // 10%
+      {&DRC::checkCopperHoleClearances, 44, true},  // 10%
+  };
 
   if (!quick) {
-    checkDrillDrillClearances(48);  // 4%
-    checkDrillBoardClearances(52);  // 4%
-    checkSilkscreenStopmaskClearances(56);  // 4%
-    checkMinimumPthAnnularRing(59);  // 3%
-    checkMinimumNpthDrillDiameter(61);  // 2%
-    checkMinimumNpthSlotWidth(63);  // 2%
-    checkMinimumPthDrillDiameter(65);  // 2%
-    checkMinimumPthSlotWidth(67);  // 2%
-    checkMinimumSilkscreenWidth(68);  // 1%
-    checkMinimumSilkscreenTextHeight(69);  // 1%
-    checkZones(72);  // 3%
-    checkVias(74);  // 2%
-    checkAllowedNpthSlots(75);  // 1%
-    checkAllowedPthSlots(76);  // 1%
-    checkInvalidPadConnections(78);  // 2%
-    checkDeviceClearances(88);  // 10%
-    checkBoardOutline(91);  // 3%
-    checkForUnplacedComponents(93);  // 2%
-    checkForMissingConnections(95);  // 2%
-    checkForStaleObjects(97);  // 2%
+    checks += QVector<Check>{
+        {&DRC::checkDrillDrillClearances, 48, true},  // 4%
+        {&DRC::checkDrillBoardClearances, 52, true},  // 4%
+        {&DRC::checkSilkscreenStopmaskClearances, 56, true},  // 4%
+        {&DRC::checkMinimumPthAnnularRing, 59, true},  // 3%
+        {&DRC::checkMinimumNpthDrillDiameter, 61, true},  // 2%
+        {&DRC::checkMinimumNpthSlotWidth, 63, true},  // 2%
+        {&DRC::checkMinimumPthDrillDiameter, 65, true},  // 2%
+        {&DRC::checkMinimumPthSlotWidth, 67, true},  // 2%
+        {&DRC::checkMinimumSilkscreenWidth, 68, true},  // 1%
+        {&DRC::checkMinimumSilkscreenTextHeight, 69, true},  // 1%
+        {&DRC::checkZones, 72, true},  // 3%
+        {&DRC::checkVias, 74, true},  // 2%
+        {&DRC::checkAllowedNpthSlots, 75, true},  // 1%
+        {&DRC::checkAllowedPthSlots, 76, true},  // 1%
+        {&DRC::checkInvalidPadConnections, 78, true},  // 2%
+        {&DRC::checkDeviceClearances, 88, true},  // 10%
+        {&DRC::checkBoardOutline, 91, true},  // 3%
+        {&DRC::checkForUnplacedComponents, 93, true},  // 2%
+        {&DRC::checkForMissingConnections, 95, false},  // 2%
+        {&DRC::checkForStaleObjects, 97, true},  // 2%
+    };
+  }
+
+  if (parallel) {
+    runChecksInParallel(checks);  // can throw
+  } else {
+    foreach (const Check& check, checks) {
+      (this->*check.function)(check.progressEnd);  // can throw
+    }
   }
 
   emitStatus(
@@ -133,6 +156,145 @@ void BoardDesignRuleCheck::execute(bool quick) {
  *  Private Methods
  ******************************************************************************/
 
+void BoardDesignRuleCheck::runChecksInParallel(const QVector<Check>& checks) {
+  // Each check is run on its own worker object to collect its status and
+  // messages separately. Afterwards they are emitted in the original order of
+  // the checks to get exactly the same output as with sequential execution.
+  QVector<std::shared_ptr<BoardDesignRuleCheck>> workers;
+  for (int i = 0; i < checks.count(); ++i) {
+    auto worker = std::make_shared<BoardDesignRuleCheck>(mBoard, mSettings);
+    worker->mIgnorePlanes = mIgnorePlanes;
+    worker->mParallel = true;
+    worker->mCachedPaths = mCachedPaths;
+    workers.append(worker);
+  }
+
+  // Checks which modify the board need to be run in the main thread before
+  // starting the worker threads since those access the board concurrently.
+  for (int i = 0; i < checks.count(); ++i) {
+    if (!checks.at(i).threadSafe) {
+      (workers.at(i).get()->*checks.at(i).function)(
+          checks.at(i).progressEnd);  // can throw
+    }
+  }
+
+  // Start all the other checks.
+  QVector<QFuture<void>> futures;
+  for (int i = 0; i < checks.count(); ++i) {
+    const Check check = checks.at(i);
+    if (check.threadSafe) {
+      std::shared_ptr<BoardDesignRuleCheck> worker = workers.at(i);
+      futures.append(QtConcurrent::run([worker, check]() {
+        (worker.get()->*check.function)(check.progressEnd);  // can throw
+      }));
+    } else {
+      futures.append(QFuture<void>());
+    }
+  }
+
+  // Wait until all checks are finished and forward their results in the
+  // original order as soon as they are available. The local event loop keeps
+  // the UI responsive, but user input is not processed since the worker
+  // threads are reading the board. If any check failed, wait until all other
+  // checks are finished anyway since they still access the board.
+  std::exception_ptr error;
+  int forwardedChecks = 0;
+  auto forwardFinishedChecks = [&]() {
+    while ((forwardedChecks < checks.count()) &&
+           futures.at(forwardedChecks).isFinished()) {
+      try {
+        futures[forwardedChecks].waitForFinished();  // can throw
+      } catch (...) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      if (!error) {
+        const BoardDesignRuleCheck& worker = *workers.at(forwardedChecks);
+        foreach (const QString& status, worker.mProgressStatus) {
+          emitStatus(status);
+        }
+        foreach (const auto& msg, worker.mMessages) {
+          emitMessage(msg);
+        }
+        if (worker.mProgressPercent > 0) {
+          emitProgress(worker.mProgressPercent);
+        }
+      }
+      ++forwardedChecks;
+    }
+  };
+  mWorkersRunning = true;
+  {
+    QEventLoop loop;
+    int runningChecks = 0;
+    for (int i = 0; i < checks.count(); ++i) {
+      if (checks.at(i).threadSafe) {
+        QFutureWatcher<void>* watcher = new QFutureWatcher<void>(&loop);
+        connect(watcher, &QFutureWatcher<void>::finished, &loop, [&]() {
+          forwardFinishedChecks();
+          if (--runningChecks == 0) {
+            loop.quit();
+          }
+        });
+        watcher->setFuture(futures.at(i));
+        ++runningChecks;
+      }
+    }
+    if (runningChecks > 0) {
+      loop.exec(QEventLoop::ExcludeUserInputEvents);
+    }
+  }
+  mWorkersRunning = false;
+  forwardFinishedChecks();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void BoardDesignRuleCheck::emitMessagesInChunks(
+    int count,
+    const std::function<RuleCheckMessageList(int, int)>& checkRange) {
+  QVector<QFuture<RuleCheckMessageList>> futures;
+  if (mParallel && (count > 1)) {
+    const int chunks =
+        std::min(count, QThreadPool::globalInstance()->maxThreadCount() * 4);
+    const int chunkSize = (count + chunks - 1) / chunks;
+    for (int begin = 0; begin < count; begin += chunkSize) {
+      const int end = std::min(begin + chunkSize, count);
+      futures.append(QtConcurrent::run(
+          [&checkRange, begin, end]() { return checkRange(begin, end); }));
+    }
+  } else {
+    foreach (const auto& msg, checkRange(0, count)) {  // can throw
+      emitMessage(msg);
+    }
+    return;
+  }
+
+  // Emit the messages in the order of the chunks. Since the chunks access
+  // data of the caller, all of them need to be finished before returning,
+  // even if one of them failed.
+  std::exception_ptr error;
+  for (QFuture<RuleCheckMessageList>& future : futures) {
+    try {
+      const RuleCheckMessageList messages = future.result();  // can throw
+      if (!error) {
+        foreach (const auto& msg, messages) {
+          emitMessage(msg);
+        }
+      }
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 void BoardDesignRuleCheck::rebuildPlanes(int progressEnd) {
   emitStatus(tr("Rebuild planes..."));
   BoardPlaneFragmentsBuilder builder;
@@ -162,10 +324,27 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
     Length clearance;
     ClipperLib::Paths copperArea;  // Exact copper outlines
     ClipperLib::Paths clearanceArea;  // Copper outlines + clearance - tolerance
+    BoardDesignRuleCheckCache::ItemId cacheId;
   };
   typedef QVector<Item> Items;
   Items items;
 
+  // Helper to determine the clearance area of an item. If the item was not
+  // modified since the last run, the cached area is used instead.
+  BoardDesignRuleCheckCache& cache = mBoard.getDrcCache();
+  cache.beginRun();
+  auto setClearanceArea =
+      [&cache](Item& item,
+               const BoardDesignRuleCheckCache::AreaCalculator& calculator) {
+        const void* subItem = item.polygon;
+        if (item.circle) {
+          subItem = item.circle;
+        }
+        item.cacheId = cache.getClearanceArea(
+            item.item, subItem, item.startLayer, item.clearance,
+            item.copperArea, item.clearanceArea, calculator);  // can throw
+      };
+
   // Net segments.
   BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
   foreach (const BI_NetSegment* netSegment, mBoard.getNetSegments()) {
@@ -180,11 +359,14 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                   via->getNetSegment().getNetSignal(),
                                   *clearance,
                                   {},
-                                  {}});
+                                  {},
+                                  0});
       gen.addVia(*via);
       gen.takePathsTo(it->copperArea);
-      gen.addVia(*via, clearance - tolerance);
-      gen.takePathsTo(it->clearanceArea);
+      setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+        gen.addVia(*via, clearance - tolerance);
+        gen.takePathsTo(area);
+      });
     }
 
     // Net lines.
@@ -199,11 +381,14 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                     netLine->getNetSegment().getNetSignal(),
                                     *clearance,
                                     {},
-                                    {}});
+                                    {},
+                                    0});
         gen.addNetLine(*netLine);
         gen.takePathsTo(it->copperArea);
-        gen.addNetLine(*netLine, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
+        setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+          gen.addNetLine(*netLine, clearance - tolerance);
+          gen.takePathsTo(area);
+        });
       }
     }
   }
@@ -221,12 +406,15 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                     plane->getNetSignal(),
                                     *clearance,
                                     {},
-                                    {}});
+                                    {},
+                                    0});
         gen.addPlane(*plane);
         gen.takePathsTo(it->copperArea);
-        it->clearanceArea = it->copperArea;
-        ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                               maxArcTolerance());
+        setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+          area = it->copperArea;
+          ClipperHelpers::offset(area, clearance - tolerance,
+                                 maxArcTolerance());
+        });
       }
     }
   }
@@ -243,14 +431,16 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                   nullptr,
                                   *clearance,
                                   {},
-                                  {}});
+                                  {},
+                                  0});
       gen.addPolygon(polygon->getData().getPath(),
                      polygon->getData().getLineWidth(),
                      polygon->getData().isFilled());
       gen.takePathsTo(it->copperArea);
-      it->clearanceArea = it->copperArea;
-      ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                             maxArcTolerance());
+      setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+        area = it->copperArea;
+        ClipperHelpers::offset(area, clearance - tolerance, maxArcTolerance());
+      });
     }
   }
 
@@ -266,11 +456,14 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                   nullptr,
                                   *clearance,
                                   {},
-                                  {}});
+                                  {},
+                                  0});
       gen.addStrokeText(*strokeText);
       gen.takePathsTo(it->copperArea);
-      gen.addStrokeText(*strokeText, clearance - tolerance);
-      gen.takePathsTo(it->clearanceArea);
+      setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+        gen.addStrokeText(*strokeText, clearance - tolerance);
+        gen.takePathsTo(area);
+      });
     }
   }
 
@@ -293,11 +486,14 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                       pad->getCompSigInstNetSignal(),
                                       *padClearance,
                                       {},
-                                      {}});
+                                      {},
+                                      0});
           gen.addPad(*pad, *layer);
           gen.takePathsTo(it->copperArea);
-          gen.addPad(*pad, *layer, padClearance - tolerance);
-          gen.takePathsTo(it->clearanceArea);
+          setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+            gen.addPad(*pad, *layer, padClearance - tolerance);
+            gen.takePathsTo(area);
+          });
         }
       }
     }
@@ -315,13 +511,16 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                     nullptr,
                                     *clearance,
                                     {},
-                                    {}});
+                                    {},
+                                    0});
         gen.addPolygon(transform.map(polygon.getPath()), polygon.getLineWidth(),
                        polygon.isFilled());
         gen.takePathsTo(it->copperArea);
-        it->clearanceArea = it->copperArea;
-        ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                               maxArcTolerance());
+        setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+          area = it->copperArea;
+          ClipperHelpers::offset(area, clearance - tolerance,
+                                 maxArcTolerance());
+        });
       }
     }
 
@@ -338,11 +537,14 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                     nullptr,
                                     *clearance,
                                     {},
-                                    {}});
+                                    {},
+                                    0});
         gen.addCircle(circle, transform);
         gen.takePathsTo(it->copperArea);
-        gen.addCircle(circle, transform, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
+        setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+          gen.addCircle(circle, transform, clearance - tolerance);
+          gen.takePathsTo(area);
+        });
       }
     }
 
@@ -360,20 +562,22 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
                                     nullptr,
                                     *clearance,
                                     {},
-                                    {}});
+                                    {},
+                                    0});
         gen.addStrokeText(*strokeText);
         gen.takePathsTo(it->copperArea);
-        gen.addStrokeText(*strokeText, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
+        setClearanceArea(*it, [&](ClipperLib::Paths& area) {
+          gen.addStrokeText(*strokeText, clearance - tolerance);
+          gen.takePathsTo(area);
+        });
       }
     }
   }
 
   // Now check for intersections.
-  QVector<const Layer*> overlappingLayers;
-  auto layersOverlap = [this, &overlappingLayers](
-                           const Layer* start1, const Layer* end1,
-                           const Layer* start2, const Layer* end2) {
+  auto layersOverlap = [this](const Layer* start1, const Layer* end1,
+                              const Layer* start2, const Layer* end2,
+                              QVector<const Layer*>& overlappingLayers) {
     overlappingLayers.clear();
     const int first =
         std::max(start1->getCopperNumber(), start2->getCopperNumber());
@@ -387,40 +591,77 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
     }
     return !overlappingLayers.isEmpty();
   };
-  auto checkForIntersections = [](Items::Iterator& it1, Items::Iterator& it2,
+  auto checkForIntersections = [](const Item& item1, const Item& item2,
                                   QVector<Path>& locations) {
     const std::unique_ptr<ClipperLib::PolyTree> intersections =
-        ClipperHelpers::intersectToTree(it1->copperArea, it2->clearanceArea,
+        ClipperHelpers::intersectToTree(item1.copperArea, item2.clearanceArea,
                                         ClipperLib::pftEvenOdd,
                                         ClipperLib::pftEvenOdd);
     locations.append(
         ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections)));
   };
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      if (((it1->netSignal != it2->netSignal) || (!it1->netSignal) ||
-           (!it2->netSignal)) &&
-          layersOverlap(it1->startLayer, it1->endLayer, it2->startLayer,
-                        it2->endLayer)) {
-        QVector<Path> locations;
-        checkForIntersections(it1, it2, locations);
-        // Perform the check the other way around only if:
-        //  - Either the two items have individual clearances
-        //  - Or there are any intersections -> show both violations in UI
-        if ((it1->clearance != it2->clearance) || (!locations.isEmpty())) {
-          checkForIntersections(it2, it1, locations);
-        }
-        if (!locations.isEmpty()) {
-          emitMessage(std::make_shared<DrcMsgCopperCopperClearanceViolation>(
-              it1->netSignal, *it1->item, it1->polygon, it1->circle,
-              it2->netSignal, *it2->item, it2->polygon, it2->circle,
-              overlappingLayers, std::max(it1->clearance, it2->clearance),
-              locations));
+  // Only items with overlapping bounding boxes can intersect, so use a
+  // spatial index to avoid the expensive Clipper operations for all the other
+  // pairs. Note that the clearance area might be smaller than the copper area
+  // for very small clearances, thus the union of both areas is indexed.
+  QVector<ClipperLib::IntRect> bounds;
+  bounds.reserve(items.count());
+  foreach (const Item& item, items) {
+    bounds.append(
+        SpatialIndex::united(SpatialIndex::getBounds(item.copperArea),
+                             SpatialIndex::getBounds(item.clearanceArea)));
+  }
+  const SpatialIndex index(bounds);
+
+  // The results of all checked pairs, per first item. They are added to the
+  // cache afterwards to allow checking the chunks concurrently.
+  std::vector<QVector<QPair<BoardDesignRuleCheckCache::ItemId, QVector<Path>>>>
+      results(items.count());
+  auto checkRange = [&](int begin, int end) {
+    RuleCheckMessageList messages;
+    QVector<const Layer*> overlappingLayers;
+    for (int i = begin; i < end; ++i) {
+      const Item& item1 = items.at(i);
+      foreach (int k, index.queryNeighbours(i, i + 1)) {
+        const Item& item2 = items.at(k);
+        if (((item1.netSignal != item2.netSignal) || (!item1.netSignal) ||
+             (!item2.netSignal)) &&
+            layersOverlap(item1.startLayer, item1.endLayer, item2.startLayer,
+                          item2.endLayer, overlappingLayers)) {
+          QVector<Path> locations;
+          if (!cache.getPairResult(item1.cacheId, item2.cacheId, locations)) {
+            checkForIntersections(item1, item2, locations);
+            // Perform the check the other way around only if:
+            //  - Either the two items have individual clearances
+            //  - Or there are any intersections -> show both violations in UI
+            if ((item1.clearance != item2.clearance) ||
+                (!locations.isEmpty())) {
+              checkForIntersections(item2, item1, locations);
+            }
+          }
+          results[i].append(qMakePair(item2.cacheId, locations));
+          if (!locations.isEmpty()) {
+            messages.append(
+                std::make_shared<DrcMsgCopperCopperClearanceViolation>(
+                    item1.netSignal, *item1.item, item1.polygon, item1.circle,
+                    item2.netSignal, *item2.item, item2.polygon, item2.circle,
+                    overlappingLayers,
+                    std::max(item1.clearance, item2.clearance), locations));
+          }
         }
       }
     }
+    return messages;
+  };
+  emitMessagesInChunks(items.count(), checkRange);  // can throw
+
+  // Memorize the results for the next run.
+  for (int i = 0; i < items.count(); ++i) {
+    foreach (const auto& result, results.at(i)) {
+      cache.setPairResult(items.at(i).cacheId, result.first, result.second);
+    }
   }
+  cache.endRun();
 
   emitProgress(progressEnd);
 }
@@ -693,25 +934,37 @@ void BoardDesignRuleCheck::checkDrillDrillClearances(int progressEnd) {
     }
   }
 
-  // Now check for intersections.
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      const std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersectToTree(it1->areas, it2->areas,
-                                          ClipperLib::pftEvenOdd,
-                                          ClipperLib::pftEvenOdd);
-      const ClipperLib::Paths paths =
-          ClipperHelpers::flattenTree(*intersections);
-      if ((!paths.empty()) && it1->item && it1->hole && it2->item &&
-          it2->hole) {
-        const QVector<Path> locations = ClipperHelpers::convert(paths);
-        emitMessage(std::make_shared<DrcMsgDrillDrillClearanceViolation>(
-            *it1->item, *it1->hole, *it2->item, *it2->hole, clearance,
-            locations));
+  // Now check for intersections of items with overlapping bounding boxes.
+  QVector<ClipperLib::IntRect> bounds;
+  bounds.reserve(items.count());
+  foreach (const Item& item, items) {
+    bounds.append(SpatialIndex::getBounds(item.areas));
+  }
+  const SpatialIndex index(bounds);
+  auto checkRange = [&](int begin, int end) {
+    RuleCheckMessageList messages;
+    for (int i = begin; i < end; ++i) {
+      const Item& item1 = items.at(i);
+      foreach (int k, index.queryNeighbours(i, i + 1)) {
+        const Item& item2 = items.at(k);
+        const std::unique_ptr<ClipperLib::PolyTree> intersections =
+            ClipperHelpers::intersectToTree(item1.areas, item2.areas,
+                                            ClipperLib::pftEvenOdd,
+                                            ClipperLib::pftEvenOdd);
+        const ClipperLib::Paths paths =
+            ClipperHelpers::flattenTree(*intersections);
+        if ((!paths.empty()) && item1.item && item1.hole && item2.item &&
+            item2.hole) {
+          const QVector<Path> locations = ClipperHelpers::convert(paths);
+          messages.append(std::make_shared<DrcMsgDrillDrillClearanceViolation>(
+              *item1.item, *item1.hole, *item2.item, *item2.hole, clearance,
+              locations));
+        }
       }
     }
-  }
+    return messages;
+  };
+  emitMessagesInChunks(items.count(), checkRange);  // can throw
 
   emitProgress(progressEnd);
 }
@@ -1539,12 +1792,21 @@ void BoardDesignRuleCheck::checkDeviceClearances(int progressEnd) {
       }
     };
 
-    // Check for overlaps.
-    for (int i = 0; i < deviceCourtyards.count(); ++i) {
-      const BI_Device* dev1 = deviceCourtyards.keys()[i];
+    // Check for overlaps of devices with overlapping bounding boxes.
+    const QList<const BI_Device*> devices = deviceCourtyards.keys();
+    QVector<ClipperLib::IntRect> bounds;
+    bounds.reserve(devices.count());
+    foreach (const BI_Device* device, devices) {
+      bounds.append(SpatialIndex::united(
+          SpatialIndex::getBounds(deviceOutlines[device]),
+          SpatialIndex::getBounds(deviceCourtyards[device])));
+    }
+    const SpatialIndex index(bounds);
+    for (int i = 0; i < devices.count(); ++i) {
+      const BI_Device* dev1 = devices.at(i);
       Q_ASSERT(dev1);
-      for (int k = i + 1; k < deviceCourtyards.count(); ++k) {
-        const BI_Device* dev2 = deviceCourtyards.keys()[k];
+      foreach (int k, index.queryNeighbours(i, i + 1)) {
+        const BI_Device* dev2 = devices.at(k);
         Q_ASSERT(dev2);
         check(dev1, dev2);
       }
@@ -1879,15 +2141,27 @@ QVector<Path> BoardDesignRuleCheck::getBoardOutlines(
   return outlines;
 }
 
-const ClipperLib::Paths& BoardDesignRuleCheck::getCopperPaths(
+ClipperLib::Paths BoardDesignRuleCheck::getCopperPaths(
     const Layer& layer, const QSet<const NetSignal*>& netsignals) {
   const auto key = qMakePair(&layer, netsignals);
-  if (!mCachedPaths.contains(key)) {
-    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-    gen.addCopper(layer, netsignals, mIgnorePlanes);
-    mCachedPaths[key] = gen.getPaths();
+  {
+    QMutexLocker lock(&mCachedPaths->mutex);
+    auto it = mCachedPaths->paths.constFind(key);
+    if (it != mCachedPaths->paths.constEnd()) {
+      return *it;
+    }
   }
-  return mCachedPaths[key];
+
+  // Don't block other threads while generating the paths. If another thread
+  // generates the same paths in the meantime, the first result is kept.
+  BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+  gen.addCopper(layer, netsignals, mIgnorePlanes);
+  QMutexLocker lock(&mCachedPaths->mutex);
+  auto it = mCachedPaths->paths.constFind(key);
+  if (it == mCachedPaths->paths.constEnd()) {
+    it = mCachedPaths->paths.insert(key, gen.getPaths());
+  }
+  return *it;
 }
 
 ClipperLib::Paths BoardDesignRuleCheck::getDeviceOutlinePaths(
@@ -1994,7 +2268,15 @@ void BoardDesignRuleCheck::emitProgress(int percent) noexcept {
 void BoardDesignRuleCheck::emitStatus(const QString& status) noexcept {
   mProgressStatus.append(status);
   emit progressStatus(status);
-  qApp->processEvents();
+  if (!mParallel) {
+    qApp->processEvents();
+  } else if ((!mWorkersRunning) &&
+             (QThread::currentThread() == qApp->thread())) {
+    // Worker threads are started later, so make sure the board can't be
+    // modified by user input in the meantime. While they are running,
+    // events are processed by runChecksInParallel() only.
+    qApp->processEvents(QEventLoop::ExcludeUserInputEvents);
+  }
 }
 
 void BoardDesignRuleCheck::emitMessage(
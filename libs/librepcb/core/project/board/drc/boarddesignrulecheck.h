@@ -31,6 +31,9 @@
 
 #include <QtCore>
 
+#include <functional>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -66,7 +69,19 @@ public:
   const RuleCheckMessageList& getMessages() const noexcept { return mMessages; }
 
   // General Methods
-  void execute(bool quick);
+
+  /**
+   * @brief Run the design rule check
+   *
+   * @param quick     If `true`, only a few fast checks are performed and
+   *                  planes are ignored.
+   * @param parallel  If `true`, independent checks (and the item pairs of
+   *                  expensive clearance checks) are run concurrently on the
+   *                  global thread pool. The emitted signals and the
+   *                  resulting messages are exactly the same as with
+   *                  sequential execution.
+   */
+  void execute(bool quick, bool parallel = false);
 
 signals:
   void started();
@@ -75,7 +90,24 @@ signals:
   void progressMessage(const QString& msg);
   void finished();
 
+private:  // Types
+  typedef void (BoardDesignRuleCheck::*CheckFunction)(int progressEnd);
+  struct Check {
+    CheckFunction function;
+    int progressEnd;
+    bool threadSafe;  ///< False if the check modifies the board
+  };
+  struct CopperPathsCache {
+    QMutex mutex;
+    QHash<QPair<const Layer*, QSet<const NetSignal*>>, ClipperLib::Paths>
+        paths;
+  };
+
 private:  // Methods
+  void runChecksInParallel(const QVector<Check>& checks);
+  void emitMessagesInChunks(
+      int count,
+      const std::function<RuleCheckMessageList(int, int)>& checkRange);
   void rebuildPlanes(int progressEnd);
   void checkCopperCopperClearances(int progressEnd);
   void checkCopperBoardClearances(int progressEnd);
@@ -110,7 +142,7 @@ private:  // Methods
       const UnsignedLength& clearance) const;
   QVector<Path> getBoardOutlines(
       const QSet<const Layer*>& layers) const noexcept;
-  const ClipperLib::Paths& getCopperPaths(
+  ClipperLib::Paths getCopperPaths(
       const Layer& layer, const QSet<const NetSignal*>& netsignals);
   ClipperLib::Paths getDeviceOutlinePaths(const BI_Device& device,
                                           const Layer& layer);
@@ -136,11 +168,14 @@ private:  // Data
   Board& mBoard;
   const BoardDesignRuleCheckSettings& mSettings;
   bool mIgnorePlanes;
+  bool mParallel;
+  bool mWorkersRunning;  ///< Whether worker threads are accessing the board
   int mProgressPercent;
   QStringList mProgressStatus;
   RuleCheckMessageList mMessages;
-  QHash<QPair<const Layer*, QSet<const NetSignal*>>, ClipperLib::Paths>
-      mCachedPaths;
+
+  /// Shared between all workers in parallel mode, thus protected by a mutex
+  std::shared_ptr<CopperPathsCache> mCachedPaths;
 };
 
 /*******************************************************************************
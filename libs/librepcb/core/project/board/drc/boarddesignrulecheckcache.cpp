@@ -0,0 +1,124 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boarddesignrulecheckcache.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Non-Member Functions
+ ******************************************************************************/
+
+uint qHash(const BoardDesignRuleCheckCache::ItemKey& key, uint seed) noexcept {
+  seed = qHash(key.item, seed);
+  seed = qHash(key.subItem, seed);
+  seed = qHash(key.layer, seed);
+  seed = qHash(key.clearance, seed);
+  for (const ClipperLib::Path& path : key.copperArea) {
+    seed = qHashBits(path.data(), path.size() * sizeof(ClipperLib::IntPoint),
+                     seed);
+  }
+  return seed;
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardDesignRuleCheckCache::BoardDesignRuleCheckCache() noexcept
+  : mNextId(0), mItems(), mPreviousItems(), mPairs(), mPreviousPairs() {
+}
+
+BoardDesignRuleCheckCache::~BoardDesignRuleCheckCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardDesignRuleCheckCache::beginRun() noexcept {
+  // Entries of the previous run which have not been accessed since then are
+  // not needed anymore.
+  mPreviousItems.swap(mItems);
+  mItems.clear();
+  mPreviousPairs.swap(mPairs);
+  mPairs.clear();
+}
+
+void BoardDesignRuleCheckCache::endRun() noexcept {
+  mPreviousItems.clear();
+  mPreviousPairs.clear();
+}
+
+void BoardDesignRuleCheckCache::clear() noexcept {
+  mItems.clear();
+  mPreviousItems.clear();
+  mPairs.clear();
+  mPreviousPairs.clear();
+}
+
+BoardDesignRuleCheckCache::ItemId BoardDesignRuleCheckCache::getClearanceArea(
+    const void* item, const void* subItem, const Layer* layer,
+    const Length& clearance, const ClipperLib::Paths& copperArea,
+    ClipperLib::Paths& clearanceArea, const AreaCalculator& calculator) {
+  const ItemKey key{item, subItem, layer, clearance, copperArea};
+  auto it = mItems.find(key);
+  if (it == mItems.end()) {
+    auto previousIt = mPreviousItems.find(key);
+    if (previousIt != mPreviousItems.end()) {
+      it = mItems.insert(key, *previousIt);
+    } else {
+      ItemEntry entry{++mNextId, {}};
+      calculator(entry.clearanceArea);  // can throw
+      it = mItems.insert(key, entry);
+    }
+  }
+  clearanceArea = it->clearanceArea;
+  return it->id;
+}
+
+bool BoardDesignRuleCheckCache::getPairResult(
+    ItemId item1, ItemId item2, QVector<Path>& locations) const noexcept {
+  auto it = mPreviousPairs.find(qMakePair(item1, item2));
+  if (it != mPreviousPairs.end()) {
+    locations = *it;
+    return true;
+  } else {
+    return false;
+  }
+}
+
+void BoardDesignRuleCheckCache::setPairResult(
+    ItemId item1, ItemId item2, const QVector<Path>& locations) noexcept {
+  mPairs.insert(qMakePair(item1, item2), locations);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
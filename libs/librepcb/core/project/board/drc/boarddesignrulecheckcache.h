@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_BOARDDESIGNRULECHECKCACHE_H
+#define LIBREPCB_CORE_BOARDDESIGNRULECHECKCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../../geometry/path.h"
+#include "../../../types/length.h"
+
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Layer;
+
+/*******************************************************************************
+ *  Class BoardDesignRuleCheckCache
+ ******************************************************************************/
+
+/**
+ * @brief Intermediate results of ::librepcb::BoardDesignRuleCheck, kept
+ *        between several runs on the same board
+ *
+ * Every cached result is keyed by the exact geometry it was calculated from,
+ * so it can never become outdated. Items modified since the previous run
+ * simply don't find their entries anymore and are re-evaluated (against their
+ * spatial neighbours only), while pairs of unmodified items reuse the result
+ * of the previous run. This avoids the need to track every single kind of
+ * board modification.
+ *
+ * Each run must be enclosed by #beginRun() and #endRun(). Entries which were
+ * not accessed during a run are discarded by #endRun(), thus the memory usage
+ * does not grow over time.
+ *
+ * @note Only #getPairResult() may be called concurrently (between
+ *       #beginRun() and #endRun()), all other methods must be called from
+ *       one thread at a time.
+ */
+class BoardDesignRuleCheckCache final {
+public:
+  // Types
+  typedef quint64 ItemId;
+  typedef std::function<void(ClipperLib::Paths&)> AreaCalculator;
+
+  // Constructors / Destructor
+  BoardDesignRuleCheckCache() noexcept;
+  BoardDesignRuleCheckCache(const BoardDesignRuleCheckCache& other) = delete;
+  ~BoardDesignRuleCheckCache() noexcept;
+
+  // General Methods
+  void beginRun() noexcept;
+  void endRun() noexcept;
+  void clear() noexcept;
+
+  /**
+   * @brief Get the clearance area of a copper item
+   *
+   * @param item          The board item (e.g. a via or device).
+   * @param subItem       Identifies the object within `item` if there are
+   *                      several ones (e.g. a footprint polygon), or
+   *                      `nullptr`.
+   * @param layer         The copper layer the area refers to.
+   * @param clearance     The clearance the area was calculated with.
+   * @param copperArea    The exact copper area of the item.
+   * @param clearanceArea Output parameter for the clearance area.
+   * @param calculator    Called to calculate the clearance area if it is not
+   *                      cached yet.
+   *
+   * @return An ID which identifies the item in its current state. Pass it to
+   *         #getPairResult() and #setPairResult().
+   */
+  ItemId getClearanceArea(const void* item, const void* subItem,
+                          const Layer* layer, const Length& clearance,
+                          const ClipperLib::Paths& copperArea,
+                          ClipperLib::Paths& clearanceArea,
+                          const AreaCalculator& calculator);
+
+  bool getPairResult(ItemId item1, ItemId item2,
+                     QVector<Path>& locations) const noexcept;
+  void setPairResult(ItemId item1, ItemId item2,
+                     const QVector<Path>& locations) noexcept;
+
+  // Operator Overloadings
+  BoardDesignRuleCheckCache& operator=(const BoardDesignRuleCheckCache& rhs) =
+      delete;
+
+private:  // Types
+  struct ItemKey {
+    const void* item;
+    const void* subItem;
+    const Layer* layer;
+    Length clearance;
+    ClipperLib::Paths copperArea;
+
+    bool operator==(const ItemKey& rhs) const noexcept {
+      return (item == rhs.item) && (subItem == rhs.subItem) &&
+          (layer == rhs.layer) && (clearance == rhs.clearance) &&
+          (copperArea == rhs.copperArea);
+    }
+  };
+  struct ItemEntry {
+    ItemId id;
+    ClipperLib::Paths clearanceArea;
+  };
+  typedef QPair<ItemId, ItemId> PairKey;
+
+  friend uint qHash(const ItemKey& key, uint seed) noexcept;
+
+private:  // Data
+  ItemId mNextId;
+  QHash<ItemKey, ItemEntry> mItems;
+  QHash<ItemKey, ItemEntry> mPreviousItems;
+  QHash<PairKey, QVector<Path>> mPairs;
+  QHash<PairKey, QVector<Path>> mPreviousPairs;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
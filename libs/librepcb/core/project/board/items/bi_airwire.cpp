@@ -37,7 +37,14 @@ namespace librepcb {
 
 BI_AirWire::BI_AirWire(Board& board, const NetSignal& netsignal,
                        const BI_NetLineAnchor& p1, const BI_NetLineAnchor& p2)
-  : BI_Base(board), mNetSignal(netsignal), mP1(p1), mP2(p2) {
+  : BI_Base(board),
+    mNetSignal(netsignal),
+    mP1(p1),
+    mP2(p2),
+    mP1Anchor(p1.toTraceAnchor()),
+    mP2Anchor(p2.toTraceAnchor()),
+    mP1Position(p1.getPosition()),
+    mP2Position(p2.getPosition()) {
 }
 
 BI_AirWire::~BI_AirWire() noexcept {
@@ -51,6 +58,22 @@ bool BI_AirWire::isVertical() const noexcept {
   return (mP1.getPosition() == mP2.getPosition());
 }
 
+bool BI_AirWire::connects(const BI_NetLineAnchor& p1,
+                          const BI_NetLineAnchor& p2) const noexcept {
+  // Note: Only the address of the referenced anchor is compared since it
+  // might already be deleted.
+  auto matches = [](const BI_NetLineAnchor& anchor,
+                    const BI_NetLineAnchor& ref, const TraceAnchor& refAnchor,
+                    const Point& refPos) {
+    return (&anchor == &ref) && (anchor.getPosition() == refPos) &&
+        (anchor.toTraceAnchor() == refAnchor);
+  };
+  return (matches(p1, mP1, mP1Anchor, mP1Position) &&
+          matches(p2, mP2, mP2Anchor, mP2Position)) ||
+      (matches(p1, mP2, mP2Anchor, mP2Position) &&
+       matches(p2, mP1, mP1Anchor, mP1Position));
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../../geometry/trace.h"
+#include "../../../types/point.h"
 #include "bi_base.h"
 
 #include <QtCore>
@@ -59,6 +61,21 @@ public:
   const BI_NetLineAnchor& getP2() const noexcept { return mP2; }
   bool isVertical() const noexcept;
 
+  /**
+   * @brief Check whether this airwire still connects the given anchors
+   *
+   * Compares the anchors with the UUIDs and positions they had when this
+   * airwire was created. The anchors referenced by this airwire are not
+   * accessed since they might have been deleted in the meantime.
+   *
+   * @param p1  First anchor (the order of the anchors doesn't matter).
+   * @param p2  Second anchor.
+   *
+   * @return Whether the airwire is still valid for the given anchors.
+   */
+  bool connects(const BI_NetLineAnchor& p1,
+                const BI_NetLineAnchor& p2) const noexcept;
+
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
@@ -70,6 +87,14 @@ private:
   const NetSignal& mNetSignal;
   const BI_NetLineAnchor& mP1;
   const BI_NetLineAnchor& mP2;
+
+  /// Anchor UUIDs and positions at construction time, used to detect
+  /// replaced or moved anchors (graphics items don't follow moved anchors,
+  /// thus such airwires need to be recreated)
+  const TraceAnchor mP1Anchor;
+  const TraceAnchor mP2Anchor;
+  const Point mP1Position;
+  const Point mP2Position;
 };
 
 /*******************************************************************************
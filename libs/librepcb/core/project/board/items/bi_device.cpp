@@ -274,6 +274,7 @@ void BI_Device::addStrokeText(BI_StrokeText& text) {
     text.addToBoard();  // can throw
   }
   mStrokeTexts.insert(text.getData().getUuid(), &text);
+  mBoard.setModified();
   emit strokeTextAdded(text);
 }
 
@@ -285,6 +286,7 @@ void BI_Device::removeStrokeText(BI_StrokeText& text) {
     text.removeFromBoard();  // can throw
   }
   mStrokeTexts.remove(text.getData().getUuid());
+  mBoard.setModified();
   emit strokeTextRemoved(text);
 }
 
@@ -295,6 +297,7 @@ void BI_Device::removeStrokeText(BI_StrokeText& text) {
 void BI_Device::setPosition(const Point& pos) noexcept {
   if (pos != mPosition) {
     mPosition = pos;
+    mBoard.setModified();
     onEdited.notify(Event::PositionChanged);
     mBoard.invalidatePlanes();
   }
@@ -303,6 +306,7 @@ void BI_Device::setPosition(const Point& pos) noexcept {
 void BI_Device::setRotation(const Angle& rot) noexcept {
   if (rot != mRotation) {
     mRotation = rot;
+    mBoard.setModified();
     onEdited.notify(Event::RotationChanged);
     mBoard.invalidatePlanes();
   }
@@ -314,6 +318,7 @@ void BI_Device::setMirrored(bool mirror) {
       throw LogicError(__FILE__, __LINE__);
     }
     mMirrored = mirror;
+    mBoard.setModified();
     onEdited.notify(Event::MirroredChanged);
     mBoard.invalidatePlanes();
   }
@@ -322,12 +327,14 @@ void BI_Device::setMirrored(bool mirror) {
 void BI_Device::setLocked(bool locked) noexcept {
   if (locked != mLocked) {
     mLocked = locked;
+    mBoard.setModified();
   }
 }
 
 void BI_Device::setAttributes(const AttributeList& attributes) noexcept {
   if (attributes != mAttributes) {
     mAttributes = attributes;
+    mBoard.setModified();
     emit attributesChanged();
   }
 }
@@ -337,6 +344,7 @@ void BI_Device::setModel(const tl::optional<Uuid>& uuid) {
       uuid ? mLibPackage->getModels().get(*uuid).get() : nullptr;  // can throw
   if (model != mLibModel) {
     mLibModel = model;
+    mBoard.setModified();
     emit attributesChanged();
   }
 }
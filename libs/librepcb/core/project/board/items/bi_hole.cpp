@@ -53,6 +53,7 @@ BI_Hole::~BI_Hole() noexcept {
 
 bool BI_Hole::setDiameter(const PositiveLength& diameter) noexcept {
   if (mData.setDiameter(diameter)) {
+    mBoard.setModified();
     onEdited.notify(Event::DiameterChanged);
     updateStopMaskOffset();
     mBoard.invalidatePlanes();
@@ -64,6 +65,7 @@ bool BI_Hole::setDiameter(const PositiveLength& diameter) noexcept {
 
 bool BI_Hole::setPath(const NonEmptyPath& path) noexcept {
   if (mData.setPath(path)) {
+    mBoard.setModified();
     onEdited.notify(Event::PathChanged);
     mBoard.invalidatePlanes();
     return true;
@@ -74,6 +76,7 @@ bool BI_Hole::setPath(const NonEmptyPath& path) noexcept {
 
 bool BI_Hole::setStopMaskConfig(const MaskConfig& config) noexcept {
   if (mData.setStopMaskConfig(config)) {
+    mBoard.setModified();
     updateStopMaskOffset();
     return true;
   } else {
@@ -83,6 +86,7 @@ bool BI_Hole::setStopMaskConfig(const MaskConfig& config) noexcept {
 
 bool BI_Hole::setLocked(bool locked) noexcept {
   if (mData.setLocked(locked)) {
+    mBoard.setModified();
     return true;
   } else {
     return false;
@@ -96,6 +96,7 @@ void BI_NetSegment::setNetSignal(NetSignal* netsignal) {
       sgl.dismiss();
     }
     mNetSignal = netsignal;
+    mBoard.setModified();
   }
 }
 
@@ -181,6 +182,7 @@ void BI_NetSegment::addElements(const QList<BI_Via*>& vias,
 
   sgl.dismiss();
 
+  mBoard.setModified();
   emit elementsAdded(vias, netpoints, netlines);
 }
 
@@ -243,6 +245,7 @@ void BI_NetSegment::removeElements(const QList<BI_Via*>& vias,
 
   sgl.dismiss();
 
+  mBoard.setModified();
   emit elementsRemoved(vias, netpoints, netlines);
 }
 
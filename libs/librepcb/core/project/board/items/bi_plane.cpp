@@ -22,7 +22,9 @@
  ******************************************************************************/
 #include "bi_plane.h"
 
+#include "../../../algorithm/spatialindex.h"
 #include "../../../serialization/sexpression.h"
+#include "../../../utils/clipperhelpers.h"
 #include "../../../utils/scopeguardlist.h"
 #include "../../circuit/circuit.h"
 #include "../../circuit/netsignal.h"
@@ -57,7 +59,8 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid, const Layer& layer,
     mThermalSpokeWidth(300000),
     mLocked(false),
     mIsVisible(true),
-    mFragments() {
+    mFragments(),
+    mPreparedFragments() {
 }
 
 BI_Plane::~BI_Plane() noexcept {
@@ -70,6 +73,7 @@ BI_Plane::~BI_Plane() noexcept {
 void BI_Plane::setOutline(const Path& outline) noexcept {
   if (outline != mOutline) {
     mOutline = outline;
+    mBoard.setModified();
     onEdited.notify(Event::OutlineChanged);
     mBoard.invalidatePlanes(mLayer);
   }
@@ -79,6 +83,7 @@ void BI_Plane::setLayer(const Layer& layer) noexcept {
   if (&layer != mLayer) {
     mBoard.invalidatePlanes(mLayer);
     mLayer = &layer;
+    mBoard.setModified();
     onEdited.notify(Event::LayerChanged);
     mBoard.invalidatePlanes(mLayer);
   }
@@ -101,6 +106,7 @@ void BI_Plane::setNetSignal(NetSignal* netsignal) {
       sgl.dismiss();
     }
     mNetSignal = netsignal;
+    mBoard.setModified();
     mBoard.invalidatePlanes(mLayer);
   }
 }
@@ -108,6 +114,7 @@ void BI_Plane::setNetSignal(NetSignal* netsignal) {
 void BI_Plane::setMinWidth(const UnsignedLength& minWidth) noexcept {
   if (minWidth != mMinWidth) {
     mMinWidth = minWidth;
+    mBoard.setModified();
     mBoard.invalidatePlanes(mLayer);
   }
 }
@@ -115,6 +122,7 @@ void BI_Plane::setMinWidth(const UnsignedLength& minWidth) noexcept {
 void BI_Plane::setMinClearance(const UnsignedLength& minClearance) noexcept {
   if (minClearance != mMinClearance) {
     mMinClearance = minClearance;
+    mBoard.setModified();
     mBoard.invalidatePlanes(mLayer);
   }
 }
@@ -122,6 +130,7 @@ void BI_Plane::setMinClearance(const UnsignedLength& minClearance) noexcept {
 void BI_Plane::setConnectStyle(BI_Plane::ConnectStyle style) noexcept {
   if (style != mConnectStyle) {
     mConnectStyle = style;
+    mBoard.setModified();
     mBoard.invalidatePlanes(mLayer);
   }
 }
@@ -129,6 +138,7 @@ void BI_Plane::setConnectStyle(BI_Plane::ConnectStyle style) noexcept {
 void BI_Plane::setThermalGap(const PositiveLength& gap) noexcept {
   if (gap != mThermalGap) {
     mThermalGap = gap;
+    mBoard.setModified();
     mBoard.invalidatePlanes(mLayer);
   }
 }
@@ -136,6 +146,7 @@ void BI_Plane::setThermalGap(const PositiveLength& gap) noexcept {
 void BI_Plane::setThermalSpokeWidth(const PositiveLength& width) noexcept {
   if (width != mThermalSpokeWidth) {
     mThermalSpokeWidth = width;
+    mBoard.setModified();
     mBoard.invalidatePlanes(mLayer);
   }
 }
@@ -143,6 +154,7 @@ void BI_Plane::setThermalSpokeWidth(const PositiveLength& width) noexcept {
 void BI_Plane::setPriority(int priority) noexcept {
   if (priority != mPriority) {
     mPriority = priority;
+    mBoard.setModified();
     mBoard.invalidatePlanes(mLayer);
   }
 }
@@ -150,6 +162,7 @@ void BI_Plane::setPriority(int priority) noexcept {
 void BI_Plane::setKeepIslands(bool keep) noexcept {
   if (keep != mKeepIslands) {
     mKeepIslands = keep;
+    mBoard.setModified();
     mBoard.invalidatePlanes(mLayer);
   }
 }
@@ -157,6 +170,7 @@ void BI_Plane::setKeepIslands(bool keep) noexcept {
 void BI_Plane::setLocked(bool locked) noexcept {
   if (locked != mLocked) {
     mLocked = locked;
+    mBoard.setModified();
     onEdited.notify(Event::IsLockedChanged);
   }
 }
@@ -171,6 +185,17 @@ void BI_Plane::setVisible(bool visible) noexcept {
 void BI_Plane::setCalculatedFragments(const QVector<Path>& fragments) noexcept {
   if (fragments != mFragments) {
     mFragments = fragments;
+    // Note: Fragments are calculated by Clipper, thus they never contain arcs.
+    mPreparedFragments.clear();
+    mPreparedFragments.reserve(mFragments.count());
+    foreach (const Path& fragment, mFragments) {
+      PreparedFragment prepared;
+      foreach (const Vertex& vertex, fragment.getVertices()) {
+        prepared.path.push_back(ClipperHelpers::convert(vertex.getPos()));
+      }
+      prepared.bounds = SpatialIndex::getBounds(prepared.path);
+      mPreparedFragments.append(prepared);
+    }
     onEdited.notify(Event::FragmentsChanged);
     if (mNetSignal) {
       mBoard.scheduleAirWiresRebuild(mNetSignal);
@@ -210,6 +235,20 @@ void BI_Plane::removeFromBoard() {
   }
 }
 
+bool BI_Plane::isInFragment(int index, const Point& pos) const noexcept {
+  if ((index < 0) || (index >= mPreparedFragments.count())) {
+    return false;
+  }
+  const PreparedFragment& fragment = mPreparedFragments.at(index);
+  const ClipperLib::IntPoint point = ClipperHelpers::convert(pos);
+  if ((point.X < fragment.bounds.left) || (point.X > fragment.bounds.right) ||
+      (point.Y < fragment.bounds.top) || (point.Y > fragment.bounds.bottom)) {
+    return false;
+  }
+  // Returns 0 if outside, +1 if inside and -1 if on the outline.
+  return ClipperLib::PointInPolygon(point, fragment.path) != 0;
+}
+
 void BI_Plane::serialize(SExpression& root) const {
   root.appendChild(mUuid);
   root.appendChild("layer", *mLayer);
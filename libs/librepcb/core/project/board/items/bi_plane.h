@@ -29,6 +29,7 @@
 #include "bi_base.h"
 
 #include <librepcb/core/utils/signalslot.h>
+#include <polyclipping/clipper.hpp>
 
 #include <QtCore>
 
@@ -117,6 +118,20 @@ public:
   void addToBoard() override;
   void removeFromBoard() override;
 
+  /**
+   * @brief Check whether a point is located within a fragment
+   *
+   * This is much faster than checking the fragment paths directly since the
+   * bounding box and the Clipper path of each fragment are cached.
+   *
+   * @param index   Index of the fragment (see #getFragments()).
+   * @param pos     The point to check.
+   *
+   * @return Whether the point is located within or on the outline of the
+   *         specified fragment.
+   */
+  bool isInFragment(int index, const Point& pos) const noexcept;
+
   /**
    * @brief Serialize into ::librepcb::SExpression node
    *
@@ -127,6 +142,12 @@ public:
   // Operator Overloadings
   BI_Plane& operator=(const BI_Plane& rhs) = delete;
 
+private:  // Types
+  struct PreparedFragment {
+    ClipperLib::IntRect bounds;
+    ClipperLib::Path path;
+  };
+
 private:  // Data
   Uuid mUuid;
   const Layer* mLayer;  ///< Mandatory (never `nullptr`)
@@ -143,6 +164,7 @@ private:  // Data
   bool mIsVisible;  // volatile, not saved to file
 
   QVector<Path> mFragments;
+  QVector<PreparedFragment> mPreparedFragments;  ///< Same order as mFragments
 };
 
 /*******************************************************************************
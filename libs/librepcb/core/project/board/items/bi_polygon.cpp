@@ -50,6 +50,7 @@ BI_Polygon::~BI_Polygon() noexcept {
 bool BI_Polygon::setLayer(const Layer& layer) noexcept {
   const Layer& oldLayer = mData.getLayer();
   if (mData.setLayer(layer)) {
+    mBoard.setModified();
     onEdited.notify(Event::LayerChanged);
     invalidatePlanes(oldLayer);
     invalidatePlanes(mData.getLayer());
@@ -61,6 +62,7 @@ bool BI_Polygon::setLayer(const Layer& layer) noexcept {
 
 bool BI_Polygon::setLineWidth(const UnsignedLength& width) noexcept {
   if (mData.setLineWidth(width)) {
+    mBoard.setModified();
     onEdited.notify(Event::LineWidthChanged);
     invalidatePlanes(mData.getLayer());
     return true;
@@ -71,6 +73,7 @@ bool BI_Polygon::setLineWidth(const UnsignedLength& width) noexcept {
 
 bool BI_Polygon::setPath(const Path& path) noexcept {
   if (mData.setPath(path)) {
+    mBoard.setModified();
     onEdited.notify(Event::PathChanged);
     invalidatePlanes(mData.getLayer());
     return true;
@@ -81,6 +84,7 @@ bool BI_Polygon::setPath(const Path& path) noexcept {
 
 bool BI_Polygon::setIsFilled(bool isFilled) noexcept {
   if (mData.setIsFilled(isFilled)) {
+    mBoard.setModified();
     onEdited.notify(Event::IsFilledChanged);
     invalidatePlanes(mData.getLayer());
     return true;
@@ -91,6 +95,7 @@ bool BI_Polygon::setIsFilled(bool isFilled) noexcept {
 
 bool BI_Polygon::setIsGrabArea(bool isGrabArea) noexcept {
   if (mData.setIsGrabArea(isGrabArea)) {
+    mBoard.setModified();
     onEdited.notify(Event::IsGrabAreaChanged);
     return true;
   } else {
@@ -100,6 +105,7 @@ bool BI_Polygon::setIsGrabArea(bool isGrabArea) noexcept {
 
 bool BI_Polygon::setLocked(bool locked) noexcept {
   if (mData.setLocked(locked)) {
+    mBoard.setModified();
     onEdited.notify(Event::IsLockedChanged);
     return true;
   } else {
@@ -65,6 +65,7 @@ BI_StrokeText::~BI_StrokeText() noexcept {
 bool BI_StrokeText::setLayer(const Layer& layer) noexcept {
   const Layer& oldLayer = mData.getLayer();
   if (mData.setLayer(layer)) {
+    mBoard.setModified();
     onEdited.notify(Event::LayerChanged);
     invalidatePlanes(oldLayer);
     invalidatePlanes(mData.getLayer());
@@ -76,6 +77,7 @@ bool BI_StrokeText::setLayer(const Layer& layer) noexcept {
 
 bool BI_StrokeText::setText(const QString& text) noexcept {
   if (mData.setText(text)) {
+    mBoard.setModified();
     updateText();
     return true;
   } else {
@@ -85,6 +87,7 @@ bool BI_StrokeText::setText(const QString& text) noexcept {
 
 bool BI_StrokeText::setPosition(const Point& pos) noexcept {
   if (mData.setPosition(pos)) {
+    mBoard.setModified();
     onEdited.notify(Event::PositionChanged);
     invalidatePlanes(mData.getLayer());
     return true;
@@ -95,6 +98,7 @@ bool BI_StrokeText::setPosition(const Point& pos) noexcept {
 
 bool BI_StrokeText::setRotation(const Angle& rotation) noexcept {
   if (mData.setRotation(rotation)) {
+    mBoard.setModified();
     onEdited.notify(Event::RotationChanged);
     updatePaths();  // Auto-rotation might have changed.
     invalidatePlanes(mData.getLayer());
@@ -106,6 +110,7 @@ bool BI_StrokeText::setRotation(const Angle& rotation) noexcept {
 
 bool BI_StrokeText::setHeight(const PositiveLength& height) noexcept {
   if (mData.setHeight(height)) {
+    mBoard.setModified();
     updatePaths();
     return true;
   } else {
@@ -115,6 +120,7 @@ bool BI_StrokeText::setHeight(const PositiveLength& height) noexcept {
 
 bool BI_StrokeText::setStrokeWidth(const UnsignedLength& strokeWidth) noexcept {
   if (mData.setStrokeWidth(strokeWidth)) {
+    mBoard.setModified();
     onEdited.notify(Event::StrokeWidthChanged);
     updatePaths();  // Spacing might need to be re-calculated.
     invalidatePlanes(mData.getLayer());
@@ -127,6 +133,7 @@ bool BI_StrokeText::setStrokeWidth(const UnsignedLength& strokeWidth) noexcept {
 bool BI_StrokeText::setLetterSpacing(
     const StrokeTextSpacing& spacing) noexcept {
   if (mData.setLetterSpacing(spacing)) {
+    mBoard.setModified();
     updatePaths();
     return true;
   } else {
@@ -136,6 +143,7 @@ bool BI_StrokeText::setLetterSpacing(
 
 bool BI_StrokeText::setLineSpacing(const StrokeTextSpacing& spacing) noexcept {
   if (mData.setLineSpacing(spacing)) {
+    mBoard.setModified();
     updatePaths();
     return true;
   } else {
@@ -145,6 +153,7 @@ bool BI_StrokeText::setLineSpacing(const StrokeTextSpacing& spacing) noexcept {
 
 bool BI_StrokeText::setAlign(const Alignment& align) noexcept {
   if (mData.setAlign(align)) {
+    mBoard.setModified();
     updatePaths();
     return true;
   } else {
@@ -154,6 +163,7 @@ bool BI_StrokeText::setAlign(const Alignment& align) noexcept {
 
 bool BI_StrokeText::setMirrored(bool mirrored) noexcept {
   if (mData.setMirrored(mirrored)) {
+    mBoard.setModified();
     onEdited.notify(Event::MirroredChanged);
     updatePaths();  // Auto-rotation might have changed.
     invalidatePlanes(mData.getLayer());
@@ -165,6 +175,7 @@ bool BI_StrokeText::setMirrored(bool mirrored) noexcept {
 
 bool BI_StrokeText::setAutoRotate(bool autoRotate) noexcept {
   if (mData.setAutoRotate(autoRotate)) {
+    mBoard.setModified();
     updatePaths();
     return true;
   } else {
@@ -174,6 +185,7 @@ bool BI_StrokeText::setAutoRotate(bool autoRotate) noexcept {
 
 bool BI_StrokeText::setLocked(bool locked) noexcept {
   if (mData.setLocked(locked)) {
+    mBoard.setModified();
     return true;
   } else {
     return false;
@@ -107,6 +107,7 @@ void BI_Via::setLayers(const Layer& from, const Layer& to) {
   }
 
   if (mVia.setLayers(from, to)) {  // can throw
+    mBoard.setModified();
     onEdited.notify(Event::LayersChanged);
     updateStopMaskDiameters();
     mBoard.invalidatePlanes();
@@ -115,6 +116,7 @@ void BI_Via::setLayers(const Layer& from, const Layer& to) {
 
 void BI_Via::setPosition(const Point& position) noexcept {
   if (mVia.setPosition(position)) {
+    mBoard.setModified();
     foreach (BI_NetLine* netLine, mRegisteredNetLines) {
       netLine->updatePositions();
     }
@@ -128,6 +130,7 @@ void BI_Via::setPosition(const Point& position) noexcept {
 
 void BI_Via::setSize(const PositiveLength& size) noexcept {
   if (mVia.setSize(size)) {
+    mBoard.setModified();
     onEdited.notify(Event::SizeChanged);
     updateStopMaskDiameters();
     mBoard.invalidatePlanes();
@@ -136,6 +139,7 @@ void BI_Via::setSize(const PositiveLength& size) noexcept {
 
 void BI_Via::setDrillDiameter(const PositiveLength& diameter) noexcept {
   if (mVia.setDrillDiameter(diameter)) {
+    mBoard.setModified();
     onEdited.notify(Event::DrillDiameterChanged);
     updateStopMaskDiameters();
     mBoard.invalidatePlanes();
@@ -144,6 +148,7 @@ void BI_Via::setDrillDiameter(const PositiveLength& diameter) noexcept {
 
 void BI_Via::setExposureConfig(const MaskConfig& config) noexcept {
   if (mVia.setExposureConfig(config)) {
+    mBoard.setModified();
     updateStopMaskDiameters();
   }
 }
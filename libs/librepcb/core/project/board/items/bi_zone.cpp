@@ -52,6 +52,7 @@ BI_Zone::~BI_Zone() noexcept {
 bool BI_Zone::setLayers(const QSet<const Layer*>& layers) {
   const QSet<const Layer*> oldLayers = mData.getLayers();
   if (mData.setLayers(layers)) {
+    mBoard.setModified();
     onEdited.notify(Event::LayersChanged);
     mBoard.invalidatePlanes(oldLayers | mData.getLayers());
     return true;
@@ -62,6 +63,7 @@ bool BI_Zone::setLayers(const QSet<const Layer*>& layers) {
 
 bool BI_Zone::setRules(Zone::Rules rules) noexcept {
   if (mData.setRules(rules)) {
+    mBoard.setModified();
     onEdited.notify(Event::RulesChanged);
     mBoard.invalidatePlanes(mData.getLayers());
     return true;
@@ -72,6 +74,7 @@ bool BI_Zone::setRules(Zone::Rules rules) noexcept {
 
 bool BI_Zone::setOutline(const Path& outline) noexcept {
   if (mData.setOutline(outline)) {
+    mBoard.setModified();
     onEdited.notify(Event::OutlineChanged);
     mBoard.invalidatePlanes(mData.getLayers());
     return true;
@@ -82,6 +85,7 @@ bool BI_Zone::setOutline(const Path& outline) noexcept {
 
 bool BI_Zone::setLocked(bool locked) noexcept {
   if (mData.setLocked(locked)) {
+    mBoard.setModified();
     onEdited.notify(Event::IsLockedChanged);
     return true;
   } else {
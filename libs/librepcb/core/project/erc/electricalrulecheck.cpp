@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "electricalrulecheck.h"
 
+#include "../../exceptions.h"
 #include "../../library/cmp/component.h"
 #include "../../library/cmp/componentsignal.h"
 #include "../circuit/circuit.h"
@@ -60,6 +61,12 @@ ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
  ******************************************************************************/
 
 RuleCheckMessageList ElectricalRuleCheck::runChecks() const {
+  // Board items affect the circuit, e.g. whether net signals are used.
+  if (mProject.hasPendingBoards()) {
+    throw LogicError(__FILE__, __LINE__,
+                     "All boards must be loaded before running the ERC.");
+  }
+
   mOpenNetSignals.clear();
 
   RuleCheckMessageList msgs;
@@ -29,6 +29,7 @@
 #include "../fileio/versionfile.h"
 #include "../font/strokefontpool.h"
 #include "../serialization/sexpression.h"
+#include "../utils/scopeguard.h"
 #include "board/board.h"
 #include "board/items/bi_polygon.h"
 #include "circuit/circuit.h"
@@ -62,6 +63,7 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
     mNormOrder(),
     mCustomBomAttributes(),
     mDefaultLockComponentAssembly(false),
+    mLoadingPendingBoards(false),
     mPrimaryBoard(nullptr) {
   // Check if the file extension is correct
   if (!mFilename.endsWith(".lpp")) {
@@ -304,6 +306,7 @@ Board* Project::getBoardByName(const QString& name) const noexcept {
 }
 
 void Project::addBoard(Board& board, int newIndex) {
+  loadBoards();  // can throw
   if ((mBoards.contains(&board)) || (&board.getProject() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -343,6 +346,9 @@ void Project::addBoard(Board& board, int newIndex) {
 }
 
 void Project::removeBoard(Board& board, bool deleteBoard) {
+  if (!deleteBoard) {
+    loadBoards();  // can throw
+  }
   if ((!mBoards.contains(&board)) || (mRemovedBoards.contains(&board))) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -364,6 +370,36 @@ void Project::removeBoard(Board& board, bool deleteBoard) {
   }
 }
 
+void Project::addPendingBoard(const std::function<void()>& loader) noexcept {
+  mPendingBoards.append(loader);
+}
+
+void Project::loadBoards(int count) {
+  // Note: Loading a board adds it to this project, which must not start
+  // loading the next board.
+  if (!mLoadingPendingBoards) {
+    mLoadingPendingBoards = true;
+    auto sg = scopeGuard([this]() { mLoadingPendingBoards = false; });
+    while ((!mPendingBoards.isEmpty()) &&
+           ((count < 0) || (mBoards.count() < count))) {
+      const std::function<void()> loader = mPendingBoards.takeFirst();
+      try {
+        loader();  // can throw
+      } catch (const Exception& e) {
+        // Don't load any further boards since they would end up at wrong
+        // indices.
+        mPendingBoards.clear();
+        mPendingBoardsError = e.getMsg();
+      }
+    }
+  }
+  if (!mPendingBoardsError.isEmpty()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        tr("Failed to load boards: %1").arg(mPendingBoardsError));
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -371,6 +407,13 @@ void Project::removeBoard(Board& board, bool deleteBoard) {
 void Project::save() {
   qDebug() << "Save project files to transactional file system...";
 
+  // If some boards could not be loaded, saving would remove them.
+  if (!mPendingBoardsError.isEmpty()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        tr("Failed to load boards: %1").arg(mPendingBoardsError));
+  }
+
   // Version file.
   mDirectory->write(
       ".librepcb-project",
@@ -476,8 +519,13 @@ void Project::save() {
     mDirectory->write("schematics/schematics.lp", root.toByteArray());
   }
 
-  // Boards.
-  {
+  // Boards. Boards which are not loaded yet can't be modified, thus their
+  // files are kept as they are.
+  if (!mPendingBoards.isEmpty()) {
+    foreach (Board* board, mBoards) {
+      board->save();
+    }
+  } else {
     SExpression root = SExpression::createList("librepcb_boards");
     foreach (Board* board, mBoards) {
       root.ensureLineBreak();
@@ -34,6 +34,8 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -258,6 +260,9 @@ public:
    * @brief Get the primary board (the first one)
    *
    * @return Primary board (nullptr if there are no boards)
+   *
+   * @note Boards which are not loaded yet are not taken into account, see
+   *       #loadBoards().
    */
   const QPointer<Board>& getPrimaryBoard() noexcept { return mPrimaryBoard; }
 
@@ -434,7 +439,7 @@ public:
   /**
    * @brief Get all boards
    *
-   * @return A QList with all boards
+   * @return A QList with all loaded boards (see #loadBoards())
    */
   const QList<Board*>& getBoards() const noexcept { return mBoards; }
 
@@ -489,6 +494,35 @@ public:
    */
   void removeBoard(Board& board, bool deleteBoard = false);
 
+  /**
+   * @brief Register a board which is loaded on demand
+   *
+   * Used by ::librepcb::ProjectLoader to defer loading boards until they are
+   * needed. Pending boards are not returned by the board getters until they
+   * are loaded with #loadBoards(), in the order they were registered.
+   *
+   * @param loader  Function which loads the board and adds it to this
+   *                project with #addBoard().
+   */
+  void addPendingBoard(const std::function<void()>& loader) noexcept;
+
+  /**
+   * @brief Check if there are boards which are not loaded yet
+   *
+   * @return True if at least one board is not loaded yet
+   */
+  bool hasPendingBoards() const noexcept { return !mPendingBoards.isEmpty(); }
+
+  /**
+   * @brief Load boards which are not loaded yet
+   *
+   * @param count   Number of boards which need to be loaded, e.g. 1 for
+   *                only the primary board. -1 loads all boards.
+   *
+   * @throw Exception if a board could not be loaded
+   */
+  void loadBoards(int count = -1);
+
   // General Methods
 
   /**
@@ -631,6 +665,15 @@ private:  // Data
   /// All removed boards of this project
   QList<Board*> mRemovedBoards;
 
+  /// Loaders of boards which are not loaded yet, see #addPendingBoard()
+  QList<std::function<void()>> mPendingBoards;
+
+  /// Whether pending boards are being loaded at the moment
+  bool mLoadingPendingBoards;
+
+  /// Error message if loading a pending board failed
+  QString mPendingBoardsError;
+
   /// All approved ERC messages
   QSet<SExpression> mErcMessageApprovals;
 
@@ -23,6 +23,7 @@
 #include "projectloader.h"
 
 #include "../application.h"
+#include "../fileio/transactionalfilesystem.h"
 #include "../fileio/versionfile.h"
 #include "../library/cmp/component.h"
 #include "../library/dev/device.h"
@@ -65,6 +66,7 @@
 #include "schematic/items/si_text.h"
 #include "schematic/schematic.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -77,7 +79,9 @@ namespace librepcb {
  ******************************************************************************/
 
 ProjectLoader::ProjectLoader(QObject* parent) noexcept
-  : QObject(parent), mAutoAssignDeviceModels(false) {
+  : QObject(parent),
+    mAutoAssignDeviceModels(false),
+    mLoadBoardsOnDemand(false) {
 }
 
 ProjectLoader::~ProjectLoader() noexcept {
@@ -253,8 +257,10 @@ template <typename ElementType>
 void ProjectLoader::loadLibraryElements(
     Project& p, const QString& dirname, const QString& type,
     void (ProjectLibrary::*addFunction)(ElementType&)) {
-  // Search all subdirectories which have a valid UUID as directory name.
-  int count = 0;
+  // Search all subdirectories which have a valid UUID as directory name and
+  // open them in parallel since parsing the files is rather expensive.
+  QThread* thread = QThread::currentThread();
+  QList<QFuture<ElementType*>> futures;
   foreach (const QString& sub, p.getLibrary().getDirectory().getDirs(dirname)) {
     std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
         p.getLibrary().getDirectory(), dirname % "/" % sub));
@@ -267,10 +273,36 @@ void ProjectLoader::loadLibraryElements(
     }
 
     // Load the library element.
-    ElementType* element =
-        ElementType::open(std::move(dir)).release();  // can throw
-    (p.getLibrary().*addFunction)(*element);
-    ++count;
+    TransactionalDirectory* dirPtr = dir.release();
+    futures.append(QtConcurrent::run([dirPtr, thread]() {
+      ElementType* element =
+          ElementType::open(std::unique_ptr<TransactionalDirectory>(dirPtr))
+              .release();  // can throw
+      element->moveToThread(thread);
+      return element;
+    }));
+  }
+
+  // Add the elements in their original order. If any element failed to load,
+  // wait for the others anyway to not leak them.
+  int count = 0;
+  std::unique_ptr<Exception> error;
+  foreach (const QFuture<ElementType*>& future, futures) {
+    try {
+      std::unique_ptr<ElementType> element(future.result());  // can throw
+      if (!error) {
+        (p.getLibrary().*addFunction)(*element);  // can throw
+        element.release();
+        ++count;
+      }
+    } catch (const Exception& e) {
+      if (!error) {
+        error.reset(e.clone());
+      }
+    }
+  }
+  if (error) {
+    error->raise();
   }
 
   qDebug().nospace().noquote()
@@ -399,18 +431,25 @@ void ProjectLoader::loadSchematics(Project& p) {
   const QString fp = "schematics/schematics.lp";
   const SExpression indexRoot = SExpression::parse(
       p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  // Read and parse the files in parallel, but create the schematics
+  // sequentially in their original order.
+  QList<QPair<FilePath, QFuture<SExpression>>> files;
   foreach (const SExpression* indexNode, indexRoot.getChildren("schematic")) {
-    loadSchematic(p, indexNode->getChild("@0").getValue());
+    const FilePath fp = FilePath::fromRelative(
+        p.getPath(), indexNode->getChild("@0").getValue());
+    files.append(qMakePair(fp, parseAsync(p.getDirectory(), fp)));
+  }
+  for (const auto& file : files) {
+    loadSchematic(p, file.first, file.second.result());  // can throw
   }
   qDebug() << "Successfully loaded" << p.getSchematics().count()
            << "schematics.";
 }
 
-void ProjectLoader::loadSchematic(Project& p, const QString& relativeFilePath) {
-  const FilePath fp = FilePath::fromRelative(p.getPath(), relativeFilePath);
+void ProjectLoader::loadSchematic(Project& p, const FilePath& fp,
+                                  const SExpression& root) {
   std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
       p.getDirectory(), fp.getParentDir().toRelative(p.getPath())));
-  const SExpression root = SExpression::parse(dir->read(fp.getFilename()), fp);
 
   Schematic* schematic =
       new Schematic(p, std::move(dir), fp.getParentDir().getFilename(),
@@ -545,17 +584,47 @@ void ProjectLoader::loadBoards(Project& p) {
   const QString fp = "boards/boards.lp";
   const SExpression indexRoot = SExpression::parse(
       p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  QList<FilePath> filePaths;
   foreach (const SExpression* node, indexRoot.getChildren("board")) {
-    loadBoard(p, node->getChild("@0").getValue());
+    filePaths.append(
+        FilePath::fromRelative(p.getPath(), node->getChild("@0").getValue()));
+  }
+
+  // Load boards on demand, if requested. Not supported if the file format was
+  // upgraded since the migration needs to be finished here.
+  if (mLoadBoardsOnDemand && (!mUpgradeMessages)) {
+    Project* project = &p;
+    const bool autoAssignDeviceModels = mAutoAssignDeviceModels;
+    foreach (const FilePath& fp, filePaths) {
+      p.addPendingBoard([project, fp, autoAssignDeviceModels]() {
+        qDebug().nospace() << "Load board " << fp.toNative() << "...";
+        ProjectLoader loader;
+        loader.setAutoAssignDeviceModels(autoAssignDeviceModels);
+        loader.loadBoard(*project, fp,
+                         parseAsync(project->getDirectory(), fp)
+                             .result());  // can throw
+      });
+    }
+    qDebug() << "Deferred loading of" << filePaths.count() << "boards.";
+    return;
+  }
+
+  // Read and parse the files in parallel, but create the boards sequentially
+  // in their original order.
+  QList<QPair<FilePath, QFuture<SExpression>>> files;
+  foreach (const FilePath& fp, filePaths) {
+    files.append(qMakePair(fp, parseAsync(p.getDirectory(), fp)));
+  }
+  for (const auto& file : files) {
+    loadBoard(p, file.first, file.second.result());  // can throw
   }
   qDebug() << "Successfully loaded" << p.getBoards().count() << "boards.";
 }
 
-void ProjectLoader::loadBoard(Project& p, const QString& relativeFilePath) {
-  const FilePath fp = FilePath::fromRelative(p.getPath(), relativeFilePath);
+void ProjectLoader::loadBoard(Project& p, const FilePath& fp,
+                              const SExpression& root) {
   std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
       p.getDirectory(), fp.getParentDir().toRelative(p.getPath())));
-  const SExpression root = SExpression::parse(dir->read(fp.getFilename()), fp);
 
   Board* board = new Board(p, std::move(dir), fp.getParentDir().getFilename(),
                            deserialize<Uuid>(root.getChild("@0")),
@@ -602,8 +671,8 @@ void ProjectLoader::loadBoard(Project& p, const QString& relativeFilePath) {
     board->setDrcSettings(BoardDesignRuleCheckSettings(node));
     board->loadDrcMessageApprovals(approvalsVersion, approvals);
   }
-  board->getFabricationOutputSettings() = BoardFabricationOutputSettings(
-      root.getChild("fabrication_output_settings"));
+  board->setFabricationOutputSettings(BoardFabricationOutputSettings(
+      root.getChild("fabrication_output_settings")));
   p.addBoard(*board);
 
   foreach (const SExpression* node, root.getChildren("device")) {
@@ -833,6 +902,16 @@ void ProjectLoader::loadBoardUserSettings(Board& b) {
   }
 }
 
+QFuture<SExpression> ProjectLoader::parseAsync(
+    const TransactionalDirectory& dir, const FilePath& fp) noexcept {
+  // Note: The file system is captured by value to keep it alive even if
+  // loading the project is aborted before all files are parsed.
+  std::shared_ptr<const TransactionalFileSystem> fs = dir.getFileSystem();
+  const QString path = fp.toRelative(fs->getAbsPath());
+  return QtConcurrent::run(
+      [fs, path, fp]() { return SExpression::parse(fs->read(path), fp); });
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
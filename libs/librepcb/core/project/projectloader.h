@@ -37,6 +37,7 @@
 namespace librepcb {
 
 class Board;
+class FilePath;
 class Project;
 class ProjectLibrary;
 class SExpression;
@@ -64,6 +65,24 @@ public:
     mAutoAssignDeviceModels = v;
   }
 
+  /**
+   * @brief Defer loading boards until they are accessed the first time
+   *
+   * Useful if boards are probably not needed at all, e.g. for exporting
+   * schematics. See ::librepcb::Project::addPendingBoard() for details.
+   *
+   * @note  Circuit items don't know about board items as long as the boards
+   *        are not loaded. For example symbol texts don't show attributes of
+   *        the devices placed on the primary board. Call
+   *        ::librepcb::Project::loadBoards() if they are needed.
+   *
+   * @note  If the project needs to be upgraded to a newer file format, all
+   *        boards are loaded immediately anyway.
+   *
+   * @param v   Whether boards shall be loaded on demand or not.
+   */
+  void setLoadBoardsOnDemand(bool v) noexcept { mLoadBoardsOnDemand = v; }
+
   // General Methods
   std::unique_ptr<Project> open(
       std::unique_ptr<TransactionalDirectory> directory,
@@ -88,18 +107,21 @@ private:  // Methods
   void loadCircuit(Project& p);
   void loadErc(Project& p);
   void loadSchematics(Project& p);
-  void loadSchematic(Project& p, const QString& relativeFilePath);
+  void loadSchematic(Project& p, const FilePath& fp, const SExpression& root);
   void loadSchematicSymbol(Schematic& s, const SExpression& node);
   void loadSchematicNetSegment(Schematic& s, const SExpression& node);
   void loadBoards(Project& p);
-  void loadBoard(Project& p, const QString& relativeFilePath);
+  void loadBoard(Project& p, const FilePath& fp, const SExpression& root);
   void loadBoardDeviceInstance(Board& b, const SExpression& node);
   void loadBoardNetSegment(Board& b, const SExpression& node);
   void loadBoardPlane(Board& b, const SExpression& node);
   void loadBoardUserSettings(Board& b);
+  static QFuture<SExpression> parseAsync(const TransactionalDirectory& dir,
+                                         const FilePath& fp) noexcept;
 
 private:  // Data
   bool mAutoAssignDeviceModels;
+  bool mLoadBoardsOnDemand;
   tl::optional<QList<FileFormatMigration::Message>> mUpgradeMessages;
 };
 
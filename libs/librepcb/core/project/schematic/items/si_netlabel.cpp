@@ -70,6 +70,7 @@ Length SI_NetLabel::getApproximateWidth() noexcept {
 
 void SI_NetLabel::setPosition(const Point& position) noexcept {
   if (mNetLabel.setPosition(position)) {
+    mSchematic.setModified();
     onEdited.notify(Event::PositionChanged);
     updateAnchor();
   }
@@ -77,12 +78,14 @@ void SI_NetLabel::setPosition(const Point& position) noexcept {
 
 void SI_NetLabel::setRotation(const Angle& rotation) noexcept {
   if (mNetLabel.setRotation(rotation)) {
+    mSchematic.setModified();
     onEdited.notify(Event::RotationChanged);
   }
 }
 
 void SI_NetLabel::setMirrored(const bool mirrored) noexcept {
   if (mNetLabel.setMirrored(mirrored)) {
+    mSchematic.setModified();
     onEdited.notify(Event::MirroredChanged);
   }
 }
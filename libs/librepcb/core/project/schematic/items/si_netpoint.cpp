@@ -23,6 +23,7 @@
 #include "si_netpoint.h"
 
 #include "../../circuit/netsignal.h"
+#include "../schematic.h"
 #include "si_netsegment.h"
 
 #include <QtCore>
@@ -75,6 +76,7 @@ NetLineAnchor SI_NetPoint::toNetLineAnchor() const noexcept {
 
 void SI_NetPoint::setPosition(const Point& position) noexcept {
   if (mJunction.setPosition(position)) {
+    mSchematic.setModified();
     foreach (SI_NetLine* netLine, mRegisteredNetLines) {
       netLine->updatePositions();
     }
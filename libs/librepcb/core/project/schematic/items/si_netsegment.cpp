@@ -149,6 +149,7 @@ void SI_NetSegment::setNetSignal(NetSignal& netsignal) {
       sg.dismiss();
     }
     mNetSignal = &netsignal;
+    mSchematic.setModified();
   }
 }
 
@@ -211,6 +212,7 @@ void SI_NetSegment::addNetPointsAndNetLines(
 
   sgl.dismiss();
 
+  mSchematic.setModified();
   emit netPointsAndNetLinesAdded(netpoints, netlines);
 }
 
@@ -255,6 +257,7 @@ void SI_NetSegment::removeNetPointsAndNetLines(
 
   sgl.dismiss();
 
+  mSchematic.setModified();
   emit netPointsAndNetLinesRemoved(netpoints, netlines);
 }
 
@@ -275,6 +278,7 @@ void SI_NetSegment::addNetLabel(SI_NetLabel& netlabel) {
   }
   netlabel.addToSchematic();  // can throw
   mNetLabels.insert(netlabel.getUuid(), &netlabel);
+  mSchematic.setModified();
   emit netLabelAdded(netlabel);
 }
 
@@ -285,6 +289,7 @@ void SI_NetSegment::removeNetLabel(SI_NetLabel& netlabel) {
   }
   netlabel.removeFromSchematic();  // can throw
   mNetLabels.remove(netlabel.getUuid());
+  mSchematic.setModified();
   emit netLabelRemoved(netlabel);
 }
 
@@ -22,7 +22,7 @@
  ******************************************************************************/
 #include "si_polygon.h"
 
-#include "../../../geometry/polygon.h"
+#include "../schematic.h"
 
 #include <QtCore>
 
@@ -36,7 +36,10 @@ namespace librepcb {
  ******************************************************************************/
 
 SI_Polygon::SI_Polygon(Schematic& schematic, const Polygon& polygon)
-  : SI_Base(schematic), mPolygon(new Polygon(polygon)) {
+  : SI_Base(schematic),
+    mPolygon(new Polygon(polygon)),
+    mOnPolygonEditedSlot(*this, &SI_Polygon::polygonEdited) {
+  mPolygon->onEdited.attach(mOnPolygonEditedSlot);
 }
 
 SI_Polygon::~SI_Polygon() noexcept {
@@ -69,6 +72,17 @@ void SI_Polygon::removeFromSchematic() {
   SI_Base::removeFromSchematic();
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void SI_Polygon::polygonEdited(const Polygon& polygon,
+                               Polygon::Event event) noexcept {
+  Q_UNUSED(polygon);
+  Q_UNUSED(event);
+  mSchematic.setModified();
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
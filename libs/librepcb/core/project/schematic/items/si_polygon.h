@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../../geometry/polygon.h"
 #include "../../../types/point.h"
 #include "../../../types/uuid.h"
 #include "si_base.h"
@@ -34,7 +35,6 @@
  ******************************************************************************/
 namespace librepcb {
 
-class Polygon;
 class Schematic;
 
 /*******************************************************************************
@@ -66,8 +66,14 @@ public:
   // Operator Overloadings
   SI_Polygon& operator=(const SI_Polygon& rhs) = delete;
 
+private:  // Methods
+  void polygonEdited(const Polygon& polygon, Polygon::Event event) noexcept;
+
 private:  // Attributes
   QScopedPointer<Polygon> mPolygon;
+
+  // Slots
+  Polygon::OnEditedSlot mOnPolygonEditedSlot;
 };
 
 /*******************************************************************************
@@ -104,6 +104,7 @@ void SI_Text::removeFromSchematic() {
 
 void SI_Text::textEdited(const Text& text, Text::Event event) noexcept {
   Q_UNUSED(text);
+  mSchematic.setModified();
   switch (event) {
     case Text::Event::PositionChanged: {
       onEdited.notify(Event::PositionChanged);
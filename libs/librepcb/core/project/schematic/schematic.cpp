@@ -58,6 +58,7 @@ Schematic::Schematic(Project& project,
     mDirectoryName(directoryName),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mModified(true),
     mUuid(uuid),
     mName(name),
     mGridInterval(2540000),
@@ -100,6 +101,7 @@ bool Schematic::isEmpty() const noexcept {
 
 void Schematic::setName(const ElementName& name) noexcept {
   mName = name;
+  mModified = true;
   emit mProject.attributesChanged();
 }
 
@@ -120,6 +122,7 @@ void Schematic::addSymbol(SI_Symbol& symbol) {
   }
   symbol.addToSchematic();  // can throw
   mSymbols.insert(symbol.getUuid(), &symbol);
+  mModified = true;
   emit symbolAdded(symbol);
 }
 
@@ -129,6 +132,7 @@ void Schematic::removeSymbol(SI_Symbol& symbol) {
   }
   symbol.removeFromSchematic();  // can throw
   mSymbols.remove(symbol.getUuid());
+  mModified = true;
   emit symbolRemoved(symbol);
 }
 
@@ -149,6 +153,7 @@ void Schematic::addNetSegment(SI_NetSegment& netsegment) {
   }
   netsegment.addToSchematic();  // can throw
   mNetSegments.insert(netsegment.getUuid(), &netsegment);
+  mModified = true;
   emit netSegmentAdded(netsegment);
 }
 
@@ -159,6 +164,7 @@ void Schematic::removeNetSegment(SI_NetSegment& netsegment) {
   }
   netsegment.removeFromSchematic();  // can throw
   mNetSegments.remove(netsegment.getUuid());
+  mModified = true;
   emit netSegmentRemoved(netsegment);
 }
 
@@ -179,6 +185,7 @@ void Schematic::addPolygon(SI_Polygon& polygon) {
   }
   polygon.addToSchematic();  // can throw
   mPolygons.insert(polygon.getUuid(), &polygon);
+  mModified = true;
   emit polygonAdded(polygon);
 }
 
@@ -189,6 +196,7 @@ void Schematic::removePolygon(SI_Polygon& polygon) {
   }
   polygon.removeFromSchematic();  // can throw
   mPolygons.remove(polygon.getUuid());
+  mModified = true;
   emit polygonRemoved(polygon);
 }
 
@@ -208,6 +216,7 @@ void Schematic::addText(SI_Text& text) {
   }
   text.addToSchematic();  // can throw
   mTexts.insert(text.getUuid(), &text);
+  mModified = true;
   emit textAdded(text);
 }
 
@@ -217,6 +226,7 @@ void Schematic::removeText(SI_Text& text) {
   }
   text.removeFromSchematic();  // can throw
   mTexts.remove(text.getUuid());
+  mModified = true;
   emit textRemoved(text);
 }
 
@@ -256,6 +266,7 @@ void Schematic::addToProject() {
   }
 
   mIsAddedToProject = true;
+  mModified = true;
   sgl.dismiss();
 }
 
@@ -292,6 +303,12 @@ void Schematic::removeFromProject() {
 }
 
 void Schematic::save() {
+  // The file in the transactional directory is still up to date if nothing
+  // was modified since it was written the last time.
+  if (!mModified) {
+    return;
+  }
+
   SExpression root = SExpression::createList("librepcb_schematic");
   root.appendChild(mUuid);
   root.ensureLineBreak();
@@ -322,6 +339,7 @@ void Schematic::save() {
   }
   root.ensureLineBreak();
   mDirectory->write("schematic.lp", root.toByteArray());
+  mModified = false;
 }
 
 void Schematic::updateAllNetLabelAnchors() noexcept {
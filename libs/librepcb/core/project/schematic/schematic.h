@@ -88,6 +88,7 @@ public:
   const QString& getDirectoryName() const noexcept { return mDirectoryName; }
   TransactionalDirectory& getDirectory() noexcept { return *mDirectory; }
   bool isEmpty() const noexcept;
+  bool isModified() const noexcept { return mModified; }
 
   // Getters: Attributes
   const Uuid& getUuid() const noexcept { return mUuid; }
@@ -101,8 +102,12 @@ public:
   void setName(const ElementName& name) noexcept;
   void setGridInterval(const PositiveLength& interval) noexcept {
     mGridInterval = interval;
+    mModified = true;
+  }
+  void setGridUnit(const LengthUnit& unit) noexcept {
+    mGridUnit = unit;
+    mModified = true;
   }
-  void setGridUnit(const LengthUnit& unit) noexcept { mGridUnit = unit; }
 
   // Symbol Methods
   const QMap<Uuid, SI_Symbol*>& getSymbols() const noexcept { return mSymbols; }
@@ -134,6 +139,14 @@ public:
   void save();
   void updateAllNetLabelAnchors() noexcept;
 
+  /**
+   * @brief Mark the schematic as modified since the last #save()
+   *
+   * Must be called on every modification of the schematic file content, since
+   * #save() does not serialize unmodified schematics again.
+   */
+  void setModified() noexcept { mModified = true; }
+
   // Operator Overloadings
   Schematic& operator=(const Schematic& rhs) = delete;
   bool operator==(const Schematic& rhs) noexcept { return (this == &rhs); }
@@ -157,6 +170,7 @@ private:
   const QString mDirectoryName;
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool mIsAddedToProject;
+  bool mModified;  ///< Whether the file needs to be written on #save()
 
   // Attributes
   Uuid mUuid;
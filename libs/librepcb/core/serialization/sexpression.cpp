@@ -28,12 +28,129 @@
 #include <QtGui>
 
 #include <algorithm>
+#include <type_traits>
 
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Struct SExpression::ParserState
+ ******************************************************************************/
+
+/**
+ * @brief State of the S-Expression parser
+ *
+ * The parser works directly on the UTF-8 encoded content, only the values of
+ * tokens and strings are converted to QString. List names are shared between
+ * all nodes of the same name (implicit sharing) to avoid allocating the same
+ * strings again and again.
+ */
+struct SExpression::ParserState {
+  const char* pos;
+  const char* const end;
+  const FilePath& filePath;
+  QHash<QByteArray, QString> sharedTokens;  ///< Keys refer to the content!
+};
+
+/*******************************************************************************
+ *  Struct SExpression::ChildIndex
+ ******************************************************************************/
+
+/**
+ * @brief Index of the list children of a list with many children
+ *
+ * Maps the hash of each list child name to the index of the first child with
+ * that hash, so looking up a child by name doesn't need to scan all children.
+ * Since hashes may collide, the name of the found child still needs to be
+ * compared, and on mismatch the children have to be searched linearly.
+ */
+struct SExpression::ChildIndex : public QSharedData {
+  QHash<uint, int> firstChildren;
+};
+
+/*******************************************************************************
+ *  Non-Member Functions
+ ******************************************************************************/
+
+static inline bool isTokenChar(char c) noexcept {
+  return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+      ((c >= '0') && (c <= '9')) || (c == '\\') || (c == '.') ||
+      (c == ':') || (c == '_') || (c == '-');
+}
+
+static inline bool isSpaceChar(char c) noexcept {
+  return (c == ' ') || (c == '\f') || (c == '\r') || (c == '\t') ||
+      (c == '\v');
+}
+
+static void appendAscii(QByteArray& output, const QString& str) noexcept {
+  // Valid tokens consist of ASCII characters only, so no UTF-8 encoding is
+  // needed.
+  const int offset = output.size();
+  output.resize(offset + str.size());
+  char* data = output.data() + offset;
+  for (const QChar& c : str) {
+    *data++ = static_cast<char>(c.unicode());
+  }
+}
+
+static inline ushort unicodeOf(char c) noexcept {
+  return static_cast<uchar>(c);
+}
+
+static inline ushort unicodeOf(QChar c) noexcept {
+  return c.unicode();
+}
+
+template <typename Char>
+static uint hashName(const Char* name, int length) noexcept {
+  uint hash = 2166136261u;  // FNV-1a
+  for (int i = 0; i < length; ++i) {
+    hash = (hash ^ unicodeOf(name[i])) * 16777619u;
+  }
+  return hash;
+}
+
+template <typename Char>
+static bool nameEquals(const QString& str, const Char* name,
+                       int length) noexcept {
+  if (str.size() != length) {
+    return false;
+  }
+  const QChar* data = str.constData();
+  for (int i = 0; i < length; ++i) {
+    if (data[i].unicode() != unicodeOf(name[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Char>
+static bool parseIndex(const Char* begin, const Char* end,
+                       int& index) noexcept {
+  if ((begin == end) || ((end - begin) > 9)) {
+    return false;  // Empty or too large to be a valid index.
+  }
+  index = 0;
+  for (const Char* pos = begin; pos != end; ++pos) {
+    const ushort c = unicodeOf(*pos);
+    if ((c < '0') || (c > '9')) {
+      return false;
+    }
+    index = (index * 10) + (c - '0');
+  }
+  return true;
+}
+
+static QChar charAt(const char* pos, const char* end) noexcept {
+  // Decode only the first (possibly multi-byte) character.
+  const QString str = QString::fromUtf8(pos, std::min<qptrdiff>(end - pos, 4));
+  return str.isEmpty() ? QChar() : str.at(0);
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -49,7 +166,8 @@ SExpression::SExpression(const SExpression& other) noexcept
   : mType(other.mType),
     mValue(other.mValue),
     mChildren(other.mChildren),
-    mFilePath(other.mFilePath) {
+    mFilePath(other.mFilePath),
+    mChildIndex(other.mChildIndex) {
 }
 
 SExpression::~SExpression() noexcept {
@@ -77,6 +195,7 @@ const QString& SExpression::getValue() const {
 }
 
 QList<SExpression*> SExpression::getChildren(Type type) noexcept {
+  mChildIndex.reset();  // Children may be modified by the caller.
   QList<SExpression*> children;
   for (SExpression& child : mChildren) {
     if (child.getType() == type) {
@@ -97,6 +216,7 @@ QList<const SExpression*> SExpression::getChildren(Type type) const noexcept {
 }
 
 QList<SExpression*> SExpression::getChildren(const QString& name) noexcept {
+  mChildIndex.reset();  // Children may be modified by the caller.
   QList<SExpression*> children;
   for (SExpression& child : mChildren) {
     if (child.isList() && (child.mValue == name)) {
@@ -128,40 +248,40 @@ SExpression& SExpression::getChild(const QString& path) {
 }
 
 const SExpression& SExpression::getChild(const QString& path) const {
-  return const_cast<SExpression*>(this)->getChild(path);
+  const SExpression* child = tryGetChild(path);
+  if (child) {
+    return *child;
+  } else {
+    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+                         QString("Child not found: %1").arg(path));
+  }
+}
+
+SExpression& SExpression::getChild(const char* path) {
+  SExpression* child = tryGetChild(path);
+  return child ? *child : getChild(QString(path));  // can throw
+}
+
+const SExpression& SExpression::getChild(const char* path) const {
+  const SExpression* child = tryGetChild(path);
+  return child ? *child : getChild(QString(path));  // can throw
 }
 
 SExpression* SExpression::tryGetChild(const QString& path) noexcept {
-  SExpression* child = this;
-  foreach (const QString& name, path.split('/')) {
-    if (name.startsWith('@')) {
-      bool valid = false;
-      int index = name.mid(1).toInt(&valid);
-      if ((valid) && (index >= 0) && skipLineBreaks(child->mChildren, index)) {
-        child = &child->mChildren[index];
-      } else {
-        return nullptr;
-      }
-    } else {
-      bool found = false;
-      for (SExpression& childchild : child->mChildren) {
-        if (childchild.isList() && (childchild.mValue == name)) {
-          child = &childchild;
-          found = true;
-          break;
-        }
-      }
-      if (!found) {
-        return nullptr;
-      }
-    }
-  }
-  return child;
+  return findChild(*this, path.constData(), path.size());
 }
 
 const SExpression* SExpression::tryGetChild(
     const QString& path) const noexcept {
-  return const_cast<SExpression*>(this)->tryGetChild(path);
+  return findChild(*this, path.constData(), path.size());
+}
+
+SExpression* SExpression::tryGetChild(const char* path) noexcept {
+  return findChild(*this, path, qstrlen(path));
+}
+
+const SExpression* SExpression::tryGetChild(const char* path) const noexcept {
+  return findChild(*this, path, qstrlen(path));
 }
 
 /*******************************************************************************
@@ -200,6 +320,7 @@ SExpression& SExpression::appendList(const QString& name) {
 
 SExpression& SExpression::appendChild(const SExpression& child) {
   if (mType == Type::List) {
+    mChildIndex.reset();
     mChildren.append(child);
     return mChildren.last();
   } else {
@@ -210,6 +331,7 @@ SExpression& SExpression::appendChild(const SExpression& child) {
 void SExpression::removeChild(const SExpression& child) {
   for (int i = 0; i < mChildren.count(); ++i) {
     if (&mChildren.at(i) == &child) {
+      mChildIndex.reset();
       mChildren.removeAt(i);
       return;
     }
@@ -219,6 +341,7 @@ void SExpression::removeChild(const SExpression& child) {
 
 void SExpression::removeChildrenWithNodeRecursive(
     const SExpression& search) noexcept {
+  mChildIndex.reset();
   for (int i = mChildren.count() - 1; i >= 0; --i) {
     if (mChildren.at(i).mChildren.contains(search)) {
       mChildren.removeAt(i);
@@ -230,6 +353,7 @@ void SExpression::removeChildrenWithNodeRecursive(
 
 void SExpression::replaceRecursive(const SExpression& search,
                                    const SExpression& replace) noexcept {
+  mChildIndex.reset();
   for (SExpression& child : mChildren) {
     if (child == search) {
       child = replace;
@@ -240,11 +364,12 @@ void SExpression::replaceRecursive(const SExpression& search,
 }
 
 QByteArray SExpression::toByteArray() const {
-  QString str = toString(0);  // can throw
-  if (!str.endsWith('\n')) {
-    str += '\n';  // newline at end of file
+  QByteArray output;
+  writeTo(output, 0);  // can throw
+  if (!output.endsWith('\n')) {
+    output.append('\n');  // newline at end of file
   }
-  return str.toUtf8();
+  return output;
 }
 
 /*******************************************************************************
@@ -278,6 +403,7 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
   mValue = rhs.mValue;
   mChildren = rhs.mChildren;
   mFilePath = rhs.mFilePath;
+  mChildIndex = rhs.mChildIndex;
   return *this;
 }
 
@@ -285,27 +411,48 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
  *  Private Methods
  ******************************************************************************/
 
-QString SExpression::escapeString(const QString& string) noexcept {
-  static QHash<QChar, QString> replacements;
-  if (replacements.isEmpty()) {
-    replacements = {
-        {'"', "\\\""},  // Double quote *must* be escaped
-        {'\\', "\\\\"},  // Backslash *must* be escaped
-        {'\b', "\\b"},  // Escape backspace to increase readability
-        {'\f', "\\f"},  // Escape form feed to increase readability
-        {'\n', "\\n"},  // Escape line feed to increase readability
-        {'\r', "\\r"},  // Escape carriage return to increase readability
-        {'\t', "\\t"},  // Escape horizontal tab to increase readability
-        {'\v', "\\v"},  // Escape vertical tab to increase readability
-    };
-  }
-
-  QString escaped;
-  escaped.reserve(string.length() + (string.length() / 10));
-  foreach (const QChar& c, string) {
-    escaped += replacements.value(c, c);
+void SExpression::escapeString(const QString& string,
+                               QByteArray& output) noexcept {
+  // All escaped characters are ASCII characters, so escaping can be done on
+  // the UTF-8 encoded bytes (multi-byte sequences never contain ASCII bytes).
+  const QByteArray utf8 = string.toUtf8();
+  const char* begin = utf8.constData();
+  const char* end = begin + utf8.size();
+  for (const char* pos = begin; pos < end; ++pos) {
+    const char* replacement = nullptr;
+    switch (*pos) {
+      case '"':  // Double quote *must* be escaped
+        replacement = "\\\"";
+        break;
+      case '\\':  // Backslash *must* be escaped
+        replacement = "\\\\";
+        break;
+      case '\b':  // Escape backspace to increase readability
+        replacement = "\\b";
+        break;
+      case '\f':  // Escape form feed to increase readability
+        replacement = "\\f";
+        break;
+      case '\n':  // Escape line feed to increase readability
+        replacement = "\\n";
+        break;
+      case '\r':  // Escape carriage return to increase readability
+        replacement = "\\r";
+        break;
+      case '\t':  // Escape horizontal tab to increase readability
+        replacement = "\\t";
+        break;
+      case '\v':  // Escape vertical tab to increase readability
+        replacement = "\\v";
+        break;
+      default:
+        continue;
+    }
+    output.append(begin, pos - begin);
+    output.append(replacement, 2);
+    begin = pos + 1;
   }
-  return escaped;
+  output.append(begin, end - begin);
 }
 
 bool SExpression::isValidToken(const QString& token) noexcept {
@@ -321,25 +468,24 @@ bool SExpression::isValidToken(const QString& token) noexcept {
 }
 
 bool SExpression::isValidTokenChar(const QChar& c) noexcept {
-  static QSet<QChar> allowedSpecialChars = {'\\', '.', ':', '_', '-'};
-  return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
-      ((c >= '0') && (c <= '9')) || allowedSpecialChars.contains(c);
+  return (c.unicode() < 0x80) && isTokenChar(c.toLatin1());
 }
 
-QString SExpression::toString(int indent) const {
+void SExpression::writeTo(QByteArray& output, int indent) const {
   if (mType == Type::List) {
     if (!isValidToken(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString("Invalid S-Expression list name: %1").arg(mValue));
     }
-    QString str = '(' + mValue;
+    output.append('(');
+    appendAscii(output, mValue);
     bool lastCharIsSpace = false;
     const int lastIndex = mChildren.count() - 1;
     for (int i = 0; i < mChildren.count(); ++i) {
       const SExpression& child = mChildren.at(i);
       if ((!lastCharIsSpace) && (!child.isLineBreak())) {
-        str += ' ';
+        output.append(' ');
       }
       const bool nextChildIsLineBreak =
           (i < lastIndex) && mChildren.at(i + 1).isLineBreak();
@@ -349,19 +495,24 @@ QString SExpression::toString(int indent) const {
       if (lastCharIsSpace && (i == lastIndex)) {
         --currentIndent;
       }
-      str += child.toString(currentIndent);
+      child.writeTo(output, currentIndent);
     }
-    return str + ')';
+    output.append(')');
   } else if (mType == Type::Token) {
     if (!isValidToken(mValue)) {
       throw LogicError(__FILE__, __LINE__,
                        QString("Invalid S-Expression token: %1").arg(mValue));
     }
-    return mValue;
+    appendAscii(output, mValue);
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    output.append('"');
+    escapeString(mValue, output);
+    output.append('"');
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    output.append('\n');
+    if (indent > 0) {
+      output.append(indent, ' ');
+    }
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -389,16 +540,19 @@ SExpression SExpression::createLineBreak() {
 
 SExpression SExpression::parse(const QByteArray& content,
                                const FilePath& filePath) {
-  int index = 0;
-  QString contentStr = QString::fromUtf8(content);
-  skipWhitespaceAndComments(contentStr, index, true);  // Skip newlines as well.
-  if (index >= contentStr.length()) {
+  ParserState state{content.constData(), content.constData() + content.size(),
+                    filePath, {}};
+  if (content.startsWith("\xEF\xBB\xBF")) {
+    state.pos += 3;  // Skip UTF-8 byte order mark.
+  }
+  skipWhitespaceAndComments(state, true);  // Skip newlines as well.
+  if (state.pos >= state.end) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                          "No S-Expression node found.");
   }
-  SExpression root = parse(contentStr, index, filePath);
-  skipWhitespaceAndComments(contentStr, index, true);  // Skip newlines as well.
-  if (index < contentStr.length()) {
+  SExpression root = parse(state);
+  skipWhitespaceAndComments(state, true);  // Skip newlines as well.
+  if (state.pos < state.end) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                          "File contains more than one root node.");
   }
@@ -434,133 +588,249 @@ bool SExpression::skipLineBreaks(const QList<SExpression>& children,
   return false;
 }
 
-SExpression SExpression::parse(const QString& content, int& index,
-                               const FilePath& filePath) {
-  Q_ASSERT(index < content.length());
+template <typename Node, typename Char>
+Node* SExpression::findChild(Node& node, const Char* path,
+                             int length) noexcept {
+  Node* child = &node;
+  Node* parent = nullptr;
+  const Char* const end = path + length;
+  const Char* begin = path;
+  while (true) {
+    const Char* separator = begin;
+    while ((separator != end) && (unicodeOf(*separator) != '/')) {
+      ++separator;
+    }
+    const int nameLength = separator - begin;
+    parent = child;
+    if ((nameLength > 0) && (unicodeOf(*begin) == '@')) {
+      int index = -1;
+      if (parseIndex(begin + 1, separator, index) &&
+          skipLineBreaks(parent->mChildren, index)) {
+        child = &parent->mChildren[index];
+      } else {
+        return nullptr;
+      }
+    } else {
+      child = nullptr;
+      if (parent->mChildIndex) {
+        const QHash<uint, int>& firstChildren =
+            parent->mChildIndex->firstChildren;
+        auto it = firstChildren.constFind(hashName(begin, nameLength));
+        if (it == firstChildren.constEnd()) {
+          return nullptr;
+        }
+        Node& candidate = parent->mChildren[*it];
+        if (nameEquals(candidate.mValue, begin, nameLength)) {
+          child = &candidate;
+        }
+      }
+      if (!child) {
+        for (Node& childchild : parent->mChildren) {
+          if (childchild.isList() &&
+              nameEquals(childchild.mValue, begin, nameLength)) {
+            child = &childchild;
+            break;
+          }
+        }
+      }
+      if (!child) {
+        return nullptr;
+      }
+    }
+    if (separator == end) {
+      break;
+    }
+    begin = separator + 1;
+  }
+  if (!std::is_const<Node>::value) {
+    // The returned child may be modified (e.g. renamed) by the caller.
+    const_cast<SExpression*>(parent)->mChildIndex.reset();
+  }
+  return child;
+}
 
-  if (content.at(index) == '\n') {
-    ++index;  // consume the '\n'
-    skipWhitespaceAndComments(content, index);  // consume following spaces
+void SExpression::buildChildIndex() noexcept {
+  QExplicitlySharedDataPointer<ChildIndex> index(new ChildIndex());
+  for (int i = 0; i < mChildren.count(); ++i) {
+    const SExpression& child = mChildren.at(i);
+    if (child.isList()) {
+      const uint hash = hashName(child.mValue.constData(), child.mValue.size());
+      if (!index->firstChildren.contains(hash)) {
+        index->firstChildren.insert(hash, i);
+      }
+    }
+  }
+  mChildIndex = index;
+}
+
+SExpression SExpression::parse(ParserState& state) {
+  Q_ASSERT(state.pos < state.end);
+
+  if (*state.pos == '\n') {
+    ++state.pos;  // consume the '\n'
+    skipWhitespaceAndComments(state);  // consume following spaces
     return createLineBreak();
-  } else if (content.at(index) == '(') {
-    return parseList(content, index, filePath);
-  } else if (content.at(index) == '"') {
-    return createString(parseString(content, index, filePath));
+  } else if (*state.pos == '(') {
+    return parseList(state);
+  } else if (*state.pos == '"') {
+    return createString(parseString(state));
   } else {
-    return createToken(parseToken(content, index, filePath));
+    return createToken(parseToken(state));
   }
 }
 
-SExpression SExpression::parseList(const QString& content, int& index,
-                                   const FilePath& filePath) {
-  Q_ASSERT((index < content.length()) && (content.at(index) == '('));
+SExpression SExpression::parseList(ParserState& state) {
+  Q_ASSERT((state.pos < state.end) && (*state.pos == '('));
 
-  ++index;  // consume the '('
+  ++state.pos;  // consume the '('
 
-  SExpression list = createList(parseToken(content, index, filePath));
+  SExpression list = createList(parseToken(state, true));
 
   while (true) {
-    if (index >= content.length()) {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
+    if (state.pos >= state.end) {
+      throw FileParseError(__FILE__, __LINE__, state.filePath, -1, -1,
+                           QString(),
                            "S-Expression node ended without closing ')'.");
     }
-    if (content.at(index) == ')') {
-      ++index;  // consume the ')'
-      skipWhitespaceAndComments(content, index);  // consume following spaces
+    if (*state.pos == ')') {
+      ++state.pos;  // consume the ')'
+      skipWhitespaceAndComments(state);  // consume following spaces
       break;
     } else {
-      list.appendChild(parse(content, index, filePath));
+      list.mChildren.append(parse(state));
     }
   }
 
+  // Lists with many children are indexed to speed up looking up children.
+  if (list.mChildren.count() >= 32) {
+    list.buildChildIndex();
+  }
+
   return list;
 }
 
-QString SExpression::parseToken(const QString& content, int& index,
-                                const FilePath& filePath) {
-  int oldIndex = index;
-  while ((index < content.length()) && (isValidTokenChar(content.at(index)))) {
-    ++index;
-  }
-  QString token = content.mid(oldIndex, index - oldIndex);
-  if (token.isEmpty()) {
-    throw FileParseError(
-        __FILE__, __LINE__, filePath, -1, -1, QString(),
-        QString("Invalid token character detected: '%1'")
-            .arg(index < content.length() ? content.at(index) : QChar()));
+QString SExpression::parseToken(ParserState& state, bool shared) {
+  const char* begin = state.pos;
+  while ((state.pos < state.end) && isTokenChar(*state.pos)) {
+    ++state.pos;
+  }
+  const int length = state.pos - begin;
+  if (length == 0) {
+    throw FileParseError(__FILE__, __LINE__, state.filePath, -1, -1, QString(),
+                         QString("Invalid token character detected: '%1'")
+                             .arg(charAt(state.pos, state.end)));
+  }
+  // Tokens consist of ASCII characters only, so no UTF-8 decoding is needed.
+  QString token;
+  if (shared) {
+    const QByteArray key = QByteArray::fromRawData(begin, length);
+    auto it = state.sharedTokens.find(key);
+    if (it == state.sharedTokens.end()) {
+      it = state.sharedTokens.insert(key, QString::fromLatin1(begin, length));
+    }
+    token = *it;
+  } else {
+    token = QString::fromLatin1(begin, length);
   }
-  skipWhitespaceAndComments(content, index);  // consume following spaces
+  skipWhitespaceAndComments(state);  // consume following spaces
   return token;
 }
 
-QString SExpression::parseString(const QString& content, int& index,
-                                 const FilePath& filePath) {
-  ++index;  // consume the '"'
-
-  // Note: Until LibrePCB 0.1.5 we used the sexpresso library for escaping
-  // strings. This library escaped more characters than we do now. To still
-  // support reading the file format 0.1, we have to keep support for the
-  // old escaping behavior.
-  static QHash<QChar, QChar> escapedChars = {
-      {'\'', '\''},  // Single quote
-      {'"', '"'},  // Double quote
-      {'?', '\?'},  // Question mark
-      {'\\', '\\'},  // Backslash
-      {'a', '\a'},  // Audible bell
-      {'b', '\b'},  // Backspace
-      {'f', '\f'},  // Form feed
-      {'n', '\n'},  // Line feed
-      {'r', '\r'},  // Carriage return
-      {'t', '\t'},  // Horizontal tab
-      {'v', '\v'},  // Vertical tab
-  };
+QString SExpression::parseString(ParserState& state) {
+  ++state.pos;  // consume the '"'
 
-  QString string;
-  bool escaped = false;
+  // Strings without escape sequences are converted directly from the content,
+  // otherwise the unescaped bytes are collected in a buffer. Since all escape
+  // sequences represent ASCII characters, this can be done before the UTF-8
+  // decoding.
+  QByteArray buffer;
+  bool hasEscapeSequences = false;
+  const char* begin = state.pos;
   while (true) {
-    if (index >= content.length()) {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                           "String ended without quote.");
+    if (state.pos >= state.end) {
+      throw FileParseError(__FILE__, __LINE__, state.filePath, -1, -1,
+                           QString(), "String ended without quote.");
     }
-    const QChar& c = content.at(index);
-    if (escaped) {
-      if (escapedChars.contains(c)) {
-        string += escapedChars[c];
-        ++index;
-        escaped = false;
-      } else {
-        throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                             QString("Illegal escape sequence: '\\%1'").arg(c));
-      }
-    } else if (c == '"') {
-      ++index;  // consume the '"'
-      skipWhitespaceAndComments(content, index);  // consume following spaces
+    const char c = *state.pos;
+    if (c == '"') {
       break;
     } else if (c == '\\') {
-      escaped = true;
-      ++index;
+      buffer.append(begin, state.pos - begin);
+      hasEscapeSequences = true;
+      ++state.pos;  // consume the '\\'
+      if (state.pos >= state.end) {
+        throw FileParseError(__FILE__, __LINE__, state.filePath, -1, -1,
+                             QString(), "String ended without quote.");
+      }
+      // Note: Until LibrePCB 0.1.5 we used the sexpresso library for escaping
+      // strings. This library escaped more characters than we do now. To still
+      // support reading the file format 0.1, we have to keep support for the
+      // old escaping behavior.
+      switch (*state.pos) {
+        case '\'':  // Single quote
+        case '"':  // Double quote
+        case '?':  // Question mark
+        case '\\':  // Backslash
+          buffer.append(*state.pos);
+          break;
+        case 'a':  // Audible bell
+          buffer.append('\a');
+          break;
+        case 'b':  // Backspace
+          buffer.append('\b');
+          break;
+        case 'f':  // Form feed
+          buffer.append('\f');
+          break;
+        case 'n':  // Line feed
+          buffer.append('\n');
+          break;
+        case 'r':  // Carriage return
+          buffer.append('\r');
+          break;
+        case 't':  // Horizontal tab
+          buffer.append('\t');
+          break;
+        case 'v':  // Vertical tab
+          buffer.append('\v');
+          break;
+        default:
+          throw FileParseError(__FILE__, __LINE__, state.filePath, -1, -1,
+                               QString(),
+                               QString("Illegal escape sequence: '\\%1'")
+                                   .arg(charAt(state.pos, state.end)));
+      }
+      ++state.pos;
+      begin = state.pos;
     } else {
-      string += c;
-      ++index;
+      ++state.pos;
     }
   }
+
+  QString string;
+  if (hasEscapeSequences) {
+    buffer.append(begin, state.pos - begin);
+    string = QString::fromUtf8(buffer);
+  } else if (state.pos > begin) {
+    string = QString::fromUtf8(begin, state.pos - begin);
+  }
+  ++state.pos;  // consume the '"'
+  skipWhitespaceAndComments(state);  // consume following spaces
   return string;
 }
 
-void SExpression::skipWhitespaceAndComments(const QString& content, int& index,
-                                            bool skipNewline) {
-  static QSet<QChar> spaces = {' ', '\f', '\r', '\t', '\v'};
-
+void SExpression::skipWhitespaceAndComments(ParserState& state,
+                                            bool skipNewline) noexcept {
   bool isComment = false;
-  while (index < content.length()) {
-    const QChar& c = content.at(index);
+  while (state.pos < state.end) {
+    const char c = *state.pos;
     if (c == ';') {  // Line-comment of the Lisp language
       isComment = true;
     } else if (c == '\n') {
       isComment = false;
     }
-    if (isComment || ((skipNewline) && (c == '\n')) || spaces.contains(c)) {
-      ++index;
+    if (isComment || ((skipNewline) && (c == '\n')) || isSpaceChar(c)) {
+      ++state.pos;
     } else {
       break;
     }
@@ -131,6 +131,12 @@ public:
    *        elements. So if you acces an element by index (e.g. "@3"),
    *        the n-th child which is *not* a linebreak will be returned.
    *
+   * @note  The path is evaluated in place without any memory allocation. For
+   *        paths given as string literals, prefer the `const char*` overloads
+   *        to avoid the conversion to QString. Lists with many children
+   *        (e.g. the root node of a board) contain an index of their
+   *        children, thus looking up a child doesn't scan all of them.
+   *
    * @param path    The path to the child to get, separated by forward slashes
    *                '/'. To specify a child by index, use '@' followed by the
    *                index (e.g. '@1' to get the second child).
@@ -141,6 +147,8 @@ public:
    */
   SExpression& getChild(const QString& path);
   const SExpression& getChild(const QString& path) const;
+  SExpression& getChild(const char* path);
+  const SExpression& getChild(const char* path) const;
 
   /**
    * @brief Try get a child by path
@@ -155,6 +163,8 @@ public:
    */
   SExpression* tryGetChild(const QString& path) noexcept;
   const SExpression* tryGetChild(const QString& path) const noexcept;
+  SExpression* tryGetChild(const char* path) noexcept;
+  const SExpression* tryGetChild(const char* path) const noexcept;
 
   // Setters
   void setName(const QString& name);
@@ -194,32 +204,39 @@ public:
   static SExpression createLineBreak();
   static SExpression parse(const QByteArray& content, const FilePath& filePath);
 
+private:  // Types
+  struct ParserState;
+  struct ChildIndex;
+
 private:  // Methods
   SExpression(Type type, const QString& value);
 
   bool isMultiLine() const noexcept;
   static bool skipLineBreaks(const QList<SExpression>& children,
                              int& index) noexcept;
-  static SExpression parse(const QString& content, int& index,
-                           const FilePath& filePath);
-  static SExpression parseList(const QString& content, int& index,
-                               const FilePath& filePath);
-  static QString parseToken(const QString& content, int& index,
-                            const FilePath& filePath);
-  static QString parseString(const QString& content, int& index,
-                             const FilePath& filePath);
-  static void skipWhitespaceAndComments(const QString& content, int& index,
-                                        bool skipNewline = false);
-  static QString escapeString(const QString& string) noexcept;
+  template <typename Node, typename Char>
+  static Node* findChild(Node& node, const Char* path, int length) noexcept;
+  void buildChildIndex() noexcept;
+  static SExpression parse(ParserState& state);
+  static SExpression parseList(ParserState& state);
+  static QString parseToken(ParserState& state, bool shared = false);
+  static QString parseString(ParserState& state);
+  static void skipWhitespaceAndComments(ParserState& state,
+                                        bool skipNewline = false) noexcept;
+  static void escapeString(const QString& string, QByteArray& output) noexcept;
   static bool isValidToken(const QString& token) noexcept;
   static bool isValidTokenChar(const QChar& c) noexcept;
-  QString toString(int indent) const;
+  void writeTo(QByteArray& output, int indent) const;
 
 private:  // Data
   Type mType;
   QString mValue;  ///< either a list name, a token or a string
   QList<SExpression> mChildren;
   FilePath mFilePath;
+
+  /// Index of the list children, only built by the parser for wide lists and
+  /// discarded as soon as the children may be modified
+  QExplicitlySharedDataPointer<const ChildIndex> mChildIndex;
 };
 
 /*******************************************************************************
@@ -24,6 +24,7 @@
 
 #include "exceptions.h"
 #include "types/uuid.h"
+#include "types/version.h"
 
 #include <QtCore>
 
@@ -195,6 +196,16 @@ void SQLiteDatabase::exec(const QString& query) {
   exec(q);
 }
 
+bool SQLiteDatabase::isTrigramFullTextSearchAvailable() {
+  QSqlQuery query("SELECT sqlite_version()", mDb);
+  exec(query);  // can throw
+  const tl::optional<Version> version = query.next()
+      ? Version::tryFromString(query.value(0).toString())
+      : tl::nullopt;
+  return version && (*version >= Version::fromString("3.34")) &&
+      getSqliteCompileOptions().contains("ENABLE_FTS5");  // can throw
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -80,6 +80,16 @@ public:
   void exec(QSqlQuery& query);
   void exec(const QString& query);
 
+  /**
+   * @brief Check if the FTS5 extension with the trigram tokenizer is available
+   *
+   * @return Whether full-text search tables with substring matching can be
+   *         created (requires SQLite 3.34 or later compiled with FTS5).
+   *
+   * @see https://sqlite.org/fts5.html#the_trigram_tokenizer
+   */
+  bool isTrigramFullTextSearchAvailable();
+
   // Operator Overloadings
   SQLiteDatabase& operator=(const SQLiteDatabase& rhs) = delete;
 
@@ -25,7 +25,6 @@
 #include "../exceptions.h"
 #include "../serialization/sexpression.h"
 
-#include <QRegularExpressionValidator>
 #include <QtCore>
 
 /*******************************************************************************
@@ -33,74 +32,42 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QString Uuid::toStr() const noexcept {
+  static const char hexDigits[] = "0123456789abcdef";
+  QString str(36, Qt::Uninitialized);
+  QChar* out = str.data();
+  for (int i = 0; i < 32; ++i) {
+    if ((i == 8) || (i == 12) || (i == 16) || (i == 20)) {
+      *out++ = QLatin1Char('-');
+    }
+    const int shift = 60 - (4 * (i % 16));
+    *out++ = QLatin1Char(hexDigits[(mData[i / 16] >> shift) & 0xF]);
+  }
+  return str;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
 
 bool Uuid::isValid(const QString& str) noexcept {
-  // Note: This used to be done using a RegEx, but when profiling and
-  // optimizing the library rescan code we found that a manually unrolled
-  // comparison loop performs much better than the previous RegEx.
-  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
-  if (str.length() != 36) return false;
-
-  // Helper function
-  auto isLowerHex = [](const QChar& chr) {
-    return (chr >= QChar('0') && chr <= QChar('9')) ||
-        (chr >= QChar('a') && chr <= QChar('f'));
-  };
-
-  if (!isLowerHex(str[0])) return false;
-  if (!isLowerHex(str[1])) return false;
-  if (!isLowerHex(str[2])) return false;
-  if (!isLowerHex(str[3])) return false;
-  if (!isLowerHex(str[4])) return false;
-  if (!isLowerHex(str[5])) return false;
-  if (!isLowerHex(str[6])) return false;
-  if (!isLowerHex(str[7])) return false;
-  if (str[8] != QChar('-')) return false;
-  if (!isLowerHex(str[9])) return false;
-  if (!isLowerHex(str[10])) return false;
-  if (!isLowerHex(str[11])) return false;
-  if (!isLowerHex(str[12])) return false;
-  if (str[13] != QChar('-')) return false;
-  if (!isLowerHex(str[14])) return false;
-  if (!isLowerHex(str[15])) return false;
-  if (!isLowerHex(str[16])) return false;
-  if (!isLowerHex(str[17])) return false;
-  if (str[18] != QChar('-')) return false;
-  if (!isLowerHex(str[19])) return false;
-  if (!isLowerHex(str[20])) return false;
-  if (!isLowerHex(str[21])) return false;
-  if (!isLowerHex(str[22])) return false;
-  if (str[23] != QChar('-')) return false;
-  if (!isLowerHex(str[24])) return false;
-  if (!isLowerHex(str[25])) return false;
-  if (!isLowerHex(str[26])) return false;
-  if (!isLowerHex(str[27])) return false;
-  if (!isLowerHex(str[28])) return false;
-  if (!isLowerHex(str[29])) return false;
-  if (!isLowerHex(str[30])) return false;
-  if (!isLowerHex(str[31])) return false;
-  if (!isLowerHex(str[32])) return false;
-  if (!isLowerHex(str[33])) return false;
-  if (!isLowerHex(str[34])) return false;
-  if (!isLowerHex(str[35])) return false;
-
-  // check type of uuid
-  QUuid quuid(str);
-  if (quuid.isNull()) return false;
-  if (quuid.variant() != QUuid::DCE) return false;
-  if (quuid.version() != QUuid::Random) return false;
-
-  return true;
+  return tryFromString(str).has_value();
 }
 
 Uuid Uuid::createRandom() noexcept {
-  QString str =
-      QUuid::createUuid().toString().remove("{").remove("}").toLower();
-  if (isValid(str)) {
-    return Uuid(str);
+  const QUuid quuid = QUuid::createUuid();
+  Data data = {{(quint64(quuid.data1) << 32) | (quint64(quuid.data2) << 16) |
+                    quint64(quuid.data3),
+                0}};
+  for (int i = 0; i < 8; ++i) {
+    data[1] = (data[1] << 8) | quuid.data4[i];
+  }
+  if (hasValidType(data)) {
+    return Uuid(data);
   } else {
     // Calls abort()!
     qFatal("Not able to generate valid random UUID, terminating application!");
@@ -108,8 +75,8 @@ Uuid Uuid::createRandom() noexcept {
 }
 
 Uuid Uuid::fromString(const QString& str) {
-  if (isValid(str)) {
-    return Uuid(str);
+  if (tl::optional<Uuid> uuid = tryFromString(str)) {
+    return *uuid;
   } else {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("String is not a valid UUID: \"%1\"").arg(str));
@@ -117,13 +84,50 @@ Uuid Uuid::fromString(const QString& str) {
 }
 
 tl::optional<Uuid> Uuid::tryFromString(const QString& str) noexcept {
-  if (isValid(str)) {
-    return Uuid(str);
+  // Note: This used to be done using a RegEx, but when profiling and
+  // optimizing the library rescan code we found that a manual loop performs
+  // much better than the previous RegEx.
+  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
+  if (str.length() != 36) return tl::nullopt;
+
+  Data data = {{0, 0}};
+  int digit = 0;
+  for (int i = 0; i < 36; ++i) {
+    const ushort chr = str.at(i).unicode();
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      if (chr != '-') return tl::nullopt;
+    } else {
+      quint64 value;
+      if ((chr >= '0') && (chr <= '9')) {
+        value = chr - '0';
+      } else if ((chr >= 'a') && (chr <= 'f')) {
+        value = chr - 'a' + 10;
+      } else {
+        return tl::nullopt;
+      }
+      data[digit / 16] = (data[digit / 16] << 4) | value;
+      ++digit;
+    }
+  }
+
+  if (hasValidType(data)) {
+    return Uuid(data);
   } else {
     return tl::nullopt;
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool Uuid::hasValidType(const Data& data) noexcept {
+  // Check type of UUID: Version 4 (random) and variant DCE (RFC4122).
+  const quint64 version = (data[0] >> 12) & 0xF;
+  const quint64 variant = (data[1] >> 62) & 0x3;
+  return (version == 4) && (variant == 2);
+}
+
 /*******************************************************************************
  *  Non-Member Functions
  ******************************************************************************/
@@ -27,6 +27,8 @@
 
 #include <optional.hpp>
 
+#include <array>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -46,6 +48,10 @@ namespace librepcb {
  *
  * A valid UUID looks like this: "d79d354b-62bd-4866-996a-78941c575e78"
  *
+ * Internally the UUID is stored as a 128-bit binary value, so copying,
+ * comparing and hashing UUIDs is cheap and doesn't need any heap allocation.
+ * The ordering is the same as the ordering of the corresponding strings.
+ *
  * @note This class guarantees that only Uuid objects representing a valid UUID
  * can be created (in opposite to QUuid which allows "Null UUIDs")! If you need
  * a nullable UUID, use tl::optional<librepcb::Uuid> instead.
@@ -69,7 +75,7 @@ public:
    *
    * @param other     Another ::librepcb::Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept : mData(other.mData) {}
 
   /**
    * @brief Destructor
@@ -83,7 +89,7 @@ public:
    *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -91,18 +97,18 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (same as comparing them as strings)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mData = rhs.mData;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept { return mData == rhs.mData; }
+  bool operator!=(const Uuid& rhs) const noexcept { return mData != rhs.mData; }
+  bool operator<(const Uuid& rhs) const noexcept { return mData < rhs.mData; }
+  bool operator>(const Uuid& rhs) const noexcept { return mData > rhs.mData; }
+  bool operator<=(const Uuid& rhs) const noexcept { return mData <= rhs.mData; }
+  bool operator>=(const Uuid& rhs) const noexcept { return mData >= rhs.mData; }
   //@}
 
   // Static Methods
@@ -146,16 +152,33 @@ public:
    */
   static tl::optional<Uuid> tryFromString(const QString& str) noexcept;
 
+private:  // Types
+  typedef std::array<quint64, 2> Data;
+
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its binary value
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @param data      The 128 bits of a valid UUID
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  explicit Uuid(const Data& data) noexcept : mData(data) {}
+
+  /**
+   * @brief Check if a binary value is a valid UUID
+   *
+   * @param data      The 128 bits to check
+   *
+   * @return Whether data is a DCE UUID in version 4 (random) or not
+   */
+  static bool hasValidType(const Data& data) noexcept;
+
+  friend uint qHash(const Uuid& key, uint seed) noexcept;
 
 private:  // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  /// The 128 bits of the UUID, the most significant ones (i.e. the first
+  /// characters of the string) in the first element. Guaranteed to always
+  /// contain a valid UUID.
+  Data mData;
 };
 
 /*******************************************************************************
@@ -173,14 +196,14 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  return qHashBits(key.mData.data(), sizeof(Uuid::Data), seed);
 }
 
 }  // namespace librepcb
 
 namespace tl {
 inline uint qHash(const optional<librepcb::Uuid>& key, uint seed) noexcept {
-  return ::qHash(key ? key->toStr() : QString(), seed);
+  return key ? librepcb::qHash(*key, seed) : seed;
 }
 }  // namespace tl
 
@@ -60,7 +60,8 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
   : QObject(nullptr),
     mLibrariesPath(librariesPath),
     mFilePath(mLibrariesPath.getPathTo(
-        QString("cache_v%1.sqlite").arg(sCurrentDbVersion))) {
+        QString("cache_v%1.sqlite").arg(sCurrentDbVersion))),
+    mHasFullTextIndex(false) {
   qDebug("Load workspace library database...");
 
   // open SQLite database
@@ -68,9 +69,15 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
 
   // Check database version - actually it must match the version in the
   // filename, but if not (e.g. due to a mistake by us) we just remove the whole
-  // database and create a new one.
+  // database and create a new one. Same if the database has been created with
+  // a different SQLite library which (not) supports full-text search since
+  // the full-text search index must exist if and only if it is supported.
   int dbVersion = getDbVersion();
-  if (dbVersion != sCurrentDbVersion) {
+  mHasFullTextIndex = hasFullTextIndex();  // can throw
+  const bool fullTextIndexSupported =
+      mDb->isTrigramFullTextSearchAvailable();  // can throw
+  if ((dbVersion != sCurrentDbVersion) ||
+      (mHasFullTextIndex != fullTextIndexSupported)) {
     qWarning() << "Library database version" << dbVersion
                << "is outdated or not supported, reinitializing...";
     mDb.reset();
@@ -79,6 +86,11 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
     WorkspaceLibraryDbWriter writer(mLibrariesPath, *mDb);
     writer.createAllTables();  // can throw
     writer.addInternalData("version", sCurrentDbVersion);  // can throw
+    mHasFullTextIndex = hasFullTextIndex();  // can throw
+  }
+  if (!mHasFullTextIndex) {
+    qWarning() << "SQLite does not support full-text search, searching in "
+                  "the workspace libraries might be slow.";
   }
 
   // create library scanner object
@@ -114,20 +126,33 @@ int WorkspaceLibraryDb::getScanProgressPercent() const noexcept {
 template <>
 QList<Uuid> WorkspaceLibraryDb::find<Package>(const QString& keyword) const {
   // ATTENTION: Keep SQL in sync with the generig find() method below!
+  const bool useIndex = useFullTextIndex(keyword);
   QSqlQuery query = mDb->prepareQuery(
       "SELECT packages.uuid FROM packages "
       "LEFT JOIN packages_tr "
       "ON packages.id = packages_tr.element_id "
       "LEFT JOIN packages_alt "
       "ON packages.id = packages_alt.package_id "
-      "WHERE packages_tr.name LIKE :escapedKeyword "
-      "OR packages_tr.keywords LIKE :escapedKeyword "
-      "OR packages_alt.name LIKE :escapedKeyword "
+      "WHERE %condition "
       "OR packages.uuid = :keyword "
       "GROUP BY packages.uuid "
-      "ORDER BY packages_tr.name ASC");
-  query.bindValue(":keyword", keyword);
-  query.bindValue(":escapedKeyword", "%" + keyword + "%");
+      "ORDER BY MIN(CASE "
+      "WHEN packages_tr.name LIKE :keyword THEN 0 "
+      "WHEN packages_alt.name LIKE :keyword THEN 0 "
+      "WHEN packages_tr.name LIKE :prefix THEN 1 "
+      "WHEN packages_alt.name LIKE :prefix THEN 1 "
+      "ELSE 2 END), packages_tr.name ASC",
+      {
+          {"%condition",
+           useIndex ? "packages_tr.id IN (SELECT rowid FROM packages_tr_fts "
+                      "WHERE packages_tr_fts MATCH :phrase) "
+                      "OR packages_alt.id IN (SELECT rowid FROM "
+                      "packages_alt_fts WHERE packages_alt_fts MATCH :phrase)"
+                    : "packages_tr.name LIKE :escapedKeyword "
+                      "OR packages_tr.keywords LIKE :escapedKeyword "
+                      "OR packages_alt.name LIKE :escapedKeyword"},
+      });
+  bindFindValues(query, keyword, useIndex);
   mDb->exec(query);
 
   QList<Uuid> uuids;
@@ -334,20 +359,27 @@ FilePath WorkspaceLibraryDb::getLatestVersionFilePath(
 QList<Uuid> WorkspaceLibraryDb::find(const QString& elementsTable,
                                      const QString& keyword) const {
   // ATTENTION: Keep SQL in sync with the find<Package>() method above!
+  const bool useIndex = useFullTextIndex(keyword);
   QSqlQuery query = mDb->prepareQuery(
       "SELECT %elements.uuid FROM %elements "
       "LEFT JOIN %elements_tr "
       "ON %elements.id = %elements_tr.element_id "
-      "WHERE %elements_tr.name LIKE :escapedKeyword "
-      "OR %elements_tr.keywords LIKE :escapedKeyword "
+      "WHERE %condition "
       "OR %elements.uuid = :keyword "
       "GROUP BY %elements.uuid "
-      "ORDER BY %elements_tr.name ASC",
+      "ORDER BY MIN(CASE "
+      "WHEN %elements_tr.name LIKE :keyword THEN 0 "
+      "WHEN %elements_tr.name LIKE :prefix THEN 1 "
+      "ELSE 2 END), %elements_tr.name ASC",
       {
+          {"%condition",
+           useIndex ? "%elements_tr.id IN (SELECT rowid FROM %elements_tr_fts "
+                      "WHERE %elements_tr_fts MATCH :phrase)"
+                    : "%elements_tr.name LIKE :escapedKeyword "
+                      "OR %elements_tr.keywords LIKE :escapedKeyword"},
           {"%elements", elementsTable},
       });
-  query.bindValue(":keyword", keyword);
-  query.bindValue(":escapedKeyword", "%" + keyword + "%");
+  bindFindValues(query, keyword, useIndex);
   mDb->exec(query);
 
   QList<Uuid> uuids;
@@ -543,6 +575,35 @@ QSet<Uuid> WorkspaceLibraryDb::getUuidSet(QSqlQuery& query) {
   return uuids;
 }
 
+bool WorkspaceLibraryDb::useFullTextIndex(
+    const QString& keyword) const noexcept {
+  // The trigram tokenizer can't find keywords shorter than 3 characters.
+  return mHasFullTextIndex && (keyword.length() >= 3);
+}
+
+void WorkspaceLibraryDb::bindFindValues(QSqlQuery& query,
+                                        const QString& keyword,
+                                        bool useIndex) noexcept {
+  query.bindValue(":keyword", keyword);
+  query.bindValue(":prefix", keyword % "%");
+  if (useIndex) {
+    // Quote the keyword to search for the exact phrase (i.e. substring) and
+    // to avoid interpreting any characters as FTS5 query syntax.
+    QString phrase = keyword;
+    phrase.replace("\"", "\"\"");
+    query.bindValue(":phrase", "\"" % phrase % "\"");
+  } else {
+    query.bindValue(":escapedKeyword", "%" % keyword % "%");
+  }
+}
+
+bool WorkspaceLibraryDb::hasFullTextIndex() const {
+  QSqlQuery query = mDb->prepareQuery(
+      "SELECT COUNT(*) FROM sqlite_master "
+      "WHERE type = 'table' AND name = 'symbols_tr_fts'");
+  return mDb->count(query) > 0;  // can throw
+}
+
 int WorkspaceLibraryDb::getDbVersion() const noexcept {
   try {
     QSqlQuery query = mDb->prepareQuery(
@@ -176,11 +176,18 @@ public:
   /**
    * @brief Find elements by keyword
    *
+   * The keyword is searched as a substring of the names and keywords (and
+   * alternative names of packages) of all elements, or for an exact UUID.
+   * If supported by SQLite, a full-text search index is used for this.
+   *
    * @param keyword   Keyword to search for. Note that the translations for
    *                  all languages will be taken into account.
    *
-   * @return  UUIDs of elements matching the filter, sorted alphabetically
-   *          and without duplicates. Empty if no elements were found.
+   * @return  UUIDs of elements matching the filter, without duplicates.
+   *          Elements whose name equals the keyword come first, followed
+   *          by elements whose name starts with the keyword and then all
+   *          others, each sorted alphabetically. Empty if no elements were
+   *          found.
    */
   template <typename ElementType>
   QList<Uuid> find(const QString& keyword) const {
@@ -424,6 +431,10 @@ private:
                            const QString& categoryTable,
                            const tl::optional<Uuid>& category, int limit) const;
   static QSet<Uuid> getUuidSet(QSqlQuery& query);
+  bool useFullTextIndex(const QString& keyword) const noexcept;
+  static void bindFindValues(QSqlQuery& query, const QString& keyword,
+                             bool useIndex) noexcept;
+  bool hasFullTextIndex() const;
   int getDbVersion() const noexcept;
   template <typename ElementType>
   static QString getTable() noexcept;
@@ -435,9 +446,10 @@ private:
   const FilePath mFilePath;  ///< Path to the SQLite database file.
   QScopedPointer<SQLiteDatabase> mDb;  ///< The SQLite database.
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+  bool mHasFullTextIndex;  ///< Whether the FTS5 trigram index is available.
 
   // Constants
-  static const int sCurrentDbVersion = 5;
+  static const int sCurrentDbVersion = 7;
 };
 
 /*******************************************************************************
@@ -103,6 +103,7 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
@@ -126,6 +127,7 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
@@ -149,6 +151,7 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL"
@@ -179,6 +182,7 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL"
@@ -217,6 +221,7 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL"
@@ -247,6 +252,7 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
@@ -291,6 +297,23 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`unit` TEXT"
       ")");
 
+  // full-text search indices
+  if (mDb.isTrigramFullTextSearchAvailable()) {
+    const QList<std::pair<QString, QString>> indices = {
+        {"libraries_tr", "name, keywords"},
+        {"component_categories_tr", "name, keywords"},
+        {"package_categories_tr", "name, keywords"},
+        {"symbols_tr", "name, keywords"},
+        {"packages_tr", "name, keywords"},
+        {"packages_alt", "name"},
+        {"components_tr", "name, keywords"},
+        {"devices_tr", "name, keywords"},
+    };
+    for (const auto& index : indices) {
+      queries << createFullTextIndexQueries(index.first, index.second);
+    }
+  }
+
   // execute queries
   foreach (const QString& string, queries) {
     QSqlQuery query = mDb.prepareQuery(string);
@@ -298,6 +321,41 @@ void WorkspaceLibraryDbWriter::createAllTables() {
   }
 }
 
+QStringList WorkspaceLibraryDbWriter::createFullTextIndexQueries(
+    const QString& table, const QString& columns) noexcept {
+  // The index is an external content table, kept in sync with the indexed
+  // table by triggers. This way the index is also updated when rows are
+  // deleted by cascading foreign keys.
+  QStringList newColumns, oldColumns;
+  foreach (const QString& column, columns.split(", ")) {
+    newColumns.append("new." % column);
+    oldColumns.append("old." % column);
+  }
+  const QString insert =
+      QString("INSERT INTO %1_fts (rowid, %2) VALUES (new.id, %3); ")
+          .arg(table, columns, newColumns.join(", "));
+  const QString remove =
+      QString(
+          "INSERT INTO %1_fts (%1_fts, rowid, %2) "
+          "VALUES ('delete', old.id, %3); ")
+          .arg(table, columns, oldColumns.join(", "));
+  QStringList queries;
+  queries << QString(
+                 "CREATE VIRTUAL TABLE IF NOT EXISTS %1_fts USING fts5("
+                 "%2, content='%1', content_rowid='id', tokenize='trigram')")
+                 .arg(table, columns);
+  queries << QString("CREATE TRIGGER IF NOT EXISTS %1_fts_insert "
+                     "AFTER INSERT ON %1 BEGIN %2END")
+                 .arg(table, insert);
+  queries << QString("CREATE TRIGGER IF NOT EXISTS %1_fts_delete "
+                     "AFTER DELETE ON %1 BEGIN %2END")
+                 .arg(table, remove);
+  queries << QString("CREATE TRIGGER IF NOT EXISTS %1_fts_update "
+                     "AFTER UPDATE ON %1 BEGIN %2%3END")
+                 .arg(table, remove, insert);
+  return queries;
+}
+
 void WorkspaceLibraryDbWriter::addInternalData(const QString& key, int value) {
   QSqlQuery query = mDb.prepareQuery(
       "INSERT INTO internal (key, value_int) "
@@ -346,15 +404,17 @@ int WorkspaceLibraryDbWriter::addDevice(int libId, const FilePath& fp,
                                         const Uuid& uuid,
                                         const Version& version, bool deprecated,
                                         const Uuid& component,
-                                        const Uuid& package) {
+                                        const Uuid& package,
+                                        const QString& fingerprint) {
   QSqlQuery query = mDb.prepareQuery(
       "INSERT INTO devices "
-      "(library_id, filepath, uuid, version, deprecated, component_uuid, "
-      "package_uuid) VALUES "
-      "(:library_id, :filepath, :uuid, :version, :deprecated, :component_uuid, "
-      ":package_uuid)");
+      "(library_id, filepath, fingerprint, uuid, version, deprecated, "
+      "component_uuid, package_uuid) VALUES "
+      "(:library_id, :filepath, :fingerprint, :uuid, :version, :deprecated, "
+      ":component_uuid, :package_uuid)");
   query.bindValue(":library_id", libId);
   query.bindValue(":filepath", filePathToString(fp));
+  query.bindValue(":fingerprint", nullIfEmpty(fingerprint));
   query.bindValue(":uuid", uuid.toStr());
   query.bindValue(":version", version.toStr());
   query.bindValue(":deprecated", deprecated);
@@ -471,16 +531,18 @@ int WorkspaceLibraryDbWriter::addElement(const QString& elementsTable,
                                          int libId, const FilePath& fp,
                                          const Uuid& uuid,
                                          const Version& version,
-                                         bool deprecated) {
+                                         bool deprecated,
+                                         const QString& fingerprint) {
   QSqlQuery query = mDb.prepareQuery(
       "INSERT INTO %elements "
-      "(library_id, filepath, uuid, version, deprecated) VALUES "
-      "(:library_id, :filepath, :uuid, :version, :deprecated)",
+      "(library_id, filepath, fingerprint, uuid, version, deprecated) VALUES "
+      "(:library_id, :filepath, :fingerprint, :uuid, :version, :deprecated)",
       {
           {"%elements", elementsTable},
       });
   query.bindValue(":library_id", libId);
   query.bindValue(":filepath", filePathToString(fp));
+  query.bindValue(":fingerprint", nullIfEmpty(fingerprint));
   query.bindValue(":uuid", uuid.toStr());
   query.bindValue(":version", version.toStr());
   query.bindValue(":deprecated", deprecated);
@@ -492,16 +554,20 @@ int WorkspaceLibraryDbWriter::addCategory(const QString& categoriesTable,
                                           const Uuid& uuid,
                                           const Version& version,
                                           bool deprecated,
-                                          const tl::optional<Uuid>& parent) {
+                                          const tl::optional<Uuid>& parent,
+                                          const QString& fingerprint) {
   QSqlQuery query = mDb.prepareQuery(
       "INSERT INTO %categories "
-      "(library_id, filepath, uuid, version, deprecated, parent_uuid) VALUES "
-      "(:library_id, :filepath, :uuid, :version, :deprecated, :parent_uuid)",
+      "(library_id, filepath, fingerprint, uuid, version, deprecated, "
+      "parent_uuid) VALUES "
+      "(:library_id, :filepath, :fingerprint, :uuid, :version, :deprecated, "
+      ":parent_uuid)",
       {
           {"%categories", categoriesTable},
       });
   query.bindValue(":library_id", libId);
   query.bindValue(":filepath", filePathToString(fp));
+  query.bindValue(":fingerprint", nullIfEmpty(fingerprint));
   query.bindValue(":uuid", uuid.toStr());
   query.bindValue(":version", version.toStr());
   query.bindValue(":deprecated", deprecated);
@@ -577,6 +643,10 @@ QString WorkspaceLibraryDbWriter::nonNull(const QString& s) noexcept {
   return s.isNull() ? "" : s;
 }
 
+QVariant WorkspaceLibraryDbWriter::nullIfEmpty(const QString& s) noexcept {
+  return s.isEmpty() ? QVariant(QVariant::String) : QVariant(s);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
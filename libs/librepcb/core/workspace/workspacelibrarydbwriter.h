@@ -68,6 +68,10 @@ public:
    * @brief Create all tables to initialize the database
    *
    * This has to be done only once, after creating a new database.
+   *
+   * If supported by SQLite, full-text search indices for the element names
+   * and keywords are created as well. They are kept up to date by triggers,
+   * so no further action is required when adding or removing elements.
    */
   void createAllTables();
 
@@ -117,17 +121,20 @@ public:
    * @param uuid          UUID of the element.
    * @param version       Version of the element.
    * @param deprecated    Whether the element is deprecated or not.
+   * @param fingerprint   Fingerprint of the element directory (optional),
+   *                      see ::librepcb::WorkspaceLibraryScanner.
    * @return ID of the added element.
    */
   template <typename ElementType>
   int addElement(int libId, const FilePath& fp, const Uuid& uuid,
-                 const Version& version, bool deprecated) {
+                 const Version& version, bool deprecated,
+                 const QString& fingerprint = QString()) {
     static_assert(std::is_same<ElementType, Symbol>::value ||
                       std::is_same<ElementType, Package>::value ||
                       std::is_same<ElementType, Component>::value,
                   "Unsupported ElementType");
     return addElement(getElementTable<ElementType>(), libId, fp, uuid, version,
-                      deprecated);
+                      deprecated, fingerprint);
   }
 
   /**
@@ -140,17 +147,19 @@ public:
    * @param version       Version of the category.
    * @param deprecated    Whether the category is deprecated or not.
    * @param parent        Parent of the category.
+   * @param fingerprint   Fingerprint of the category directory (optional).
    * @return ID of the added category.
    */
   template <typename ElementType>
   int addCategory(int libId, const FilePath& fp, const Uuid& uuid,
                   const Version& version, bool deprecated,
-                  const tl::optional<Uuid>& parent) {
+                  const tl::optional<Uuid>& parent,
+                  const QString& fingerprint = QString()) {
     static_assert(std::is_same<ElementType, ComponentCategory>::value ||
                       std::is_same<ElementType, PackageCategory>::value,
                   "Unsupported ElementType");
     return addCategory(getElementTable<ElementType>(), libId, fp, uuid, version,
-                       deprecated, parent);
+                       deprecated, parent, fingerprint);
   }
 
   /**
@@ -163,11 +172,12 @@ public:
    * @param deprecated    Whether the device is deprecated or not.
    * @param component     Component UUID of the device.
    * @param package       Package UUID of the device.
+   * @param fingerprint   Fingerprint of the device directory (optional).
    * @return ID of the added device.
    */
   int addDevice(int libId, const FilePath& fp, const Uuid& uuid,
                 const Version& version, bool deprecated, const Uuid& component,
-                const Uuid& package);
+                const Uuid& package, const QString& fingerprint = QString());
 
   /**
    * @brief Add a part to a previously added device
@@ -301,10 +311,12 @@ public:
 
 private:  // Methods
   int addElement(const QString& elementsTable, int libId, const FilePath& fp,
-                 const Uuid& uuid, const Version& version, bool deprecated);
+                 const Uuid& uuid, const Version& version, bool deprecated,
+                 const QString& fingerprint);
   int addCategory(const QString& categoriesTable, int libId, const FilePath& fp,
                   const Uuid& uuid, const Version& version, bool deprecated,
-                  const tl::optional<Uuid>& parent);
+                  const tl::optional<Uuid>& parent,
+                  const QString& fingerprint);
   void removeElement(const QString& elementsTable, const FilePath& fp);
   void removeAllElements(const QString& elementsTable);
   int addTranslation(const QString& elementsTable, int elementId,
@@ -316,7 +328,10 @@ private:  // Methods
   int addToCategory(const QString& elementsTable, int elementId,
                     const Uuid& category);
   QString filePathToString(const FilePath& fp) const noexcept;
+  static QStringList createFullTextIndexQueries(
+      const QString& table, const QString& columns) noexcept;
   static QString nonNull(const QString& s) noexcept;
+  static QVariant nullIfEmpty(const QString& s) noexcept;
 
 private:  // Data
   FilePath mLibrariesRoot;
@@ -35,6 +35,7 @@
 #include "../utils/toolbox.h"
 #include "workspacelibrarydbwriter.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -127,13 +128,13 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    writer.removeAllElements<ComponentCategory>();
-    writer.removeAllElements<PackageCategory>();
-    writer.removeAllElements<Symbol>();
-    writer.removeAllElements<Package>();
-    writer.removeAllElements<Component>();
-    writer.removeAllElements<Device>();
+    // get all elements currently contained in the database
+    ElementStates cmpCats = getElementStates<ComponentCategory>(db);
+    ElementStates pkgCats = getElementStates<PackageCategory>(db);
+    ElementStates symbols = getElementStates<Symbol>(db);
+    ElementStates packages = getElementStates<Package>(db);
+    ElementStates components = getElementStates<Component>(db);
+    ElementStates devices = getElementStates<Device>(db);
 
     // scan all libraries
     int count = 0;
@@ -144,32 +145,41 @@ void WorkspaceLibraryScanner::scan() noexcept {
       int libId = libIds[fp];
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<ComponentCategory>(
-          writer, fp, lib->searchForElements<ComponentCategory>(), libId);
+          writer, fp, lib->searchForElements<ComponentCategory>(), libId,
+          cmpCats);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<PackageCategory>(
-          writer, fp, lib->searchForElements<PackageCategory>(), libId);
+          writer, fp, lib->searchForElements<PackageCategory>(), libId,
+          pkgCats);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Symbol>(writer, fp,
-                                       lib->searchForElements<Symbol>(), libId);
+      count += addElementsToDb<Symbol>(
+          writer, fp, lib->searchForElements<Symbol>(), libId, symbols);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<Package>(
-          writer, fp, lib->searchForElements<Package>(), libId);
+          writer, fp, lib->searchForElements<Package>(), libId, packages);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<Component>(
-          writer, fp, lib->searchForElements<Component>(), libId);
+          writer, fp, lib->searchForElements<Component>(), libId, components);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Device>(writer, fp,
-                                       lib->searchForElements<Device>(), libId);
+      count += addElementsToDb<Device>(
+          writer, fp, lib->searchForElements<Device>(), libId, devices);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
     // commit transaction
     if ((!mAbort) && (mSemaphore.available() == 0)) {
+      // remove elements which don't exist anymore
+      removeElementsFromDb<ComponentCategory>(writer, cmpCats);
+      removeElementsFromDb<PackageCategory>(writer, pkgCats);
+      removeElementsFromDb<Symbol>(writer, symbols);
+      removeElementsFromDb<Package>(writer, packages);
+      removeElementsFromDb<Component>(writer, components);
+      removeElementsFromDb<Device>(writer, devices);
       transactionGuard.commit();  // can throw
       qDebug() << "Workspace library scan succeeded:" << count << "elements in"
                << timer.elapsed() << "ms.";
@@ -257,74 +267,147 @@ QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
   foreach (const std::shared_ptr<Library>& lib, libs) {
     int id = dbLibIds.value(lib->getDirectory().getAbsPath());
     Q_ASSERT(id >= 0);
-    addTranslationsToDb(writer, id, *lib);
+    addTranslationsToDb<Library>(writer, id, lib->getNames(),
+                                 lib->getDescriptions(), lib->getKeywords());
   }
 
   transactionGuard.commit();  // can throw
   return dbLibIds;
 }
 
+template <typename ElementType>
+WorkspaceLibraryScanner::ElementStates
+    WorkspaceLibraryScanner::getElementStates(SQLiteDatabase& db) {
+  ElementStates states;
+  QSqlQuery query = db.prepareQuery(
+      "SELECT id, library_id, filepath, fingerprint FROM %elements",
+      {
+          {"%elements",
+           WorkspaceLibraryDbWriter::getElementTable<ElementType>()},
+      });
+  db.exec(query);  // can throw
+  while (query.next()) {
+    FilePath fp = mLibrariesPath.getPathTo(query.value(2).toString());
+    if (!fp.isValid()) throw LogicError(__FILE__, __LINE__);
+    states.insert(fp,
+                  ElementState{query.value(0).toInt(), query.value(1).toInt(),
+                               query.value(3).toString()});
+  }
+  return states;
+}
+
 template <typename ElementType>
 int WorkspaceLibraryScanner::addElementsToDb(WorkspaceLibraryDbWriter& writer,
                                              const FilePath& libPath,
-                                             const QStringList& dirs,
-                                             int libId) {
+                                             const QStringList& dirs, int libId,
+                                             ElementStates& states) {
+  // Skip elements which have not been modified since the last scan.
   int count = 0;
+  QList<FilePath> modifiedElements;
   foreach (const QString& dirpath, dirs) {
     if (mAbort || (mSemaphore.available() > 0)) break;
     const FilePath fp = libPath.getPathTo(dirpath);
-    try {
-      std::unique_ptr<ElementType> element =
-          openAndMigrate<ElementType>(fp);  // can throw
-      int id = addElementToDb(writer, libId, *element);
-      addTranslationsToDb(writer, id, *element);
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element during scan:"
-                 << fp.toNative();
+    const auto it = states.find(fp);
+    if (it != states.end()) {
+      const ElementState state = *it;
+      states.erase(it);
+      if ((state.libId == libId) && (!state.fingerprint.isEmpty()) &&
+          (state.fingerprint == getFingerprint(fp))) {
+        count++;
+        continue;
+      }
+      writer.removeElement<ElementType>(fp);  // can throw
+    }
+    modifiedElements.append(fp);
+  }
+
+  // Load the metadata of all modified elements in parallel, but add them to
+  // the database only in this thread. The number of elements being loaded at
+  // the same time is limited to keep the memory usage low if the database is
+  // slower than the parser.
+  typedef std::shared_ptr<const typename ElementType::Metadata> MetadataPtr;
+  typedef QPair<MetadataPtr, QString> LoadResult;  // Metadata & fingerprint.
+  const int maxPending = QThreadPool::globalInstance()->maxThreadCount() * 2;
+  QQueue<QPair<FilePath, QFuture<LoadResult>>> pending;
+  int index = 0;
+  while ((index < modifiedElements.count()) || (!pending.isEmpty())) {
+    const bool abort = mAbort || (mSemaphore.available() > 0);
+    if ((!abort) && (index < modifiedElements.count()) &&
+        (pending.count() < maxPending)) {
+      const FilePath fp = modifiedElements.at(index++);
+      pending.enqueue(qMakePair(
+          fp, QtConcurrent::run([this, fp]() {
+            QString fingerprint;
+            const MetadataPtr metadata =
+                tryLoadMetadata<ElementType>(fp, fingerprint);
+            return qMakePair(metadata, fingerprint);
+          })));
+    } else {
+      // Note: Pending futures need to be finished even if aborted since they
+      // access this object.
+      const QPair<FilePath, QFuture<LoadResult>> item = pending.dequeue();
+      const MetadataPtr metadata = item.second.result().first;
+      const QString fingerprint = item.second.result().second;
+      if (metadata && (!abort)) {
+        int id = addElementToDb<ElementType>(writer, libId, item.first,
+                                             *metadata, fingerprint);
+        addTranslationsToDb<ElementType>(writer, id, metadata->names,
+                                         metadata->descriptions,
+                                         metadata->keywords);
+        count++;
+      }
     }
   }
   return count;
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addElementToDb(WorkspaceLibraryDbWriter& writer,
-                                            int libId,
-                                            const ElementType& element) {
+void WorkspaceLibraryScanner::removeElementsFromDb(
+    WorkspaceLibraryDbWriter& writer, const ElementStates& states) {
+  foreach (const FilePath& fp, states.keys()) {
+    writer.removeElement<ElementType>(fp);  // can throw
+  }
+}
+
+template <typename ElementType>
+int WorkspaceLibraryScanner::addElementToDb(
+    WorkspaceLibraryDbWriter& writer, int libId, const FilePath& fp,
+    const typename ElementType::Metadata& metadata,
+    const QString& fingerprint) {
   const int id = writer.addElement<ElementType>(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated());
-  addToCategories(writer, id, element);
+      libId, fp, metadata.uuid, metadata.version, metadata.deprecated,
+      fingerprint);
+  addToCategories<ElementType>(writer, id, metadata.categories);
   return id;
 }
 
 template <>
 int WorkspaceLibraryScanner::addElementToDb<ComponentCategory>(
-    WorkspaceLibraryDbWriter& writer, int libId,
-    const ComponentCategory& element) {
+    WorkspaceLibraryDbWriter& writer, int libId, const FilePath& fp,
+    const ComponentCategory::Metadata& metadata, const QString& fingerprint) {
   return writer.addCategory<ComponentCategory>(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated(), element.getParentUuid());
+      libId, fp, metadata.uuid, metadata.version, metadata.deprecated,
+      metadata.parent, fingerprint);
 }
 
 template <>
 int WorkspaceLibraryScanner::addElementToDb<PackageCategory>(
-    WorkspaceLibraryDbWriter& writer, int libId,
-    const PackageCategory& element) {
+    WorkspaceLibraryDbWriter& writer, int libId, const FilePath& fp,
+    const PackageCategory::Metadata& metadata, const QString& fingerprint) {
   return writer.addCategory<PackageCategory>(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated(), element.getParentUuid());
+      libId, fp, metadata.uuid, metadata.version, metadata.deprecated,
+      metadata.parent, fingerprint);
 }
 
 template <>
 int WorkspaceLibraryScanner::addElementToDb<Package>(
-    WorkspaceLibraryDbWriter& writer, int libId, const Package& element) {
-  const int id = writer.addElement<Package>(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated());
-  addToCategories(writer, id, element);
-  foreach (const Package::AlternativeName& name,
-           element.getAlternativeNames()) {
+    WorkspaceLibraryDbWriter& writer, int libId, const FilePath& fp,
+    const Package::Metadata& metadata, const QString& fingerprint) {
+  const int id =
+      writer.addElement<Package>(libId, fp, metadata.uuid, metadata.version,
+                                 metadata.deprecated, fingerprint);
+  addToCategories<Package>(writer, id, metadata.categories);
+  foreach (const Package::AlternativeName& name, metadata.alternativeNames) {
     writer.addAlternativeName(id, name.name, name.reference);
   }
   return id;
@@ -332,13 +415,13 @@ int WorkspaceLibraryScanner::addElementToDb<Package>(
 
 template <>
 int WorkspaceLibraryScanner::addElementToDb<Device>(
-    WorkspaceLibraryDbWriter& writer, int libId, const Device& element) {
-  const int id = writer.addDevice(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated(), element.getComponentUuid(),
-      element.getPackageUuid());
-  addToCategories(writer, id, element);
-  for (const Part& part : element.getParts()) {
+    WorkspaceLibraryDbWriter& writer, int libId, const FilePath& fp,
+    const Device::Metadata& metadata, const QString& fingerprint) {
+  const int id = writer.addDevice(libId, fp, metadata.uuid, metadata.version,
+                                  metadata.deprecated, metadata.componentUuid,
+                                  metadata.packageUuid, fingerprint);
+  addToCategories<Device>(writer, id, metadata.categories);
+  for (const Part& part : metadata.parts) {
     if (!part.isEmpty()) {
       const int partId =
           writer.addPart(id, *part.getMpn(), *part.getManufacturer());
@@ -353,24 +436,61 @@ int WorkspaceLibraryScanner::addElementToDb<Device>(
 template <typename ElementType>
 void WorkspaceLibraryScanner::addTranslationsToDb(
     WorkspaceLibraryDbWriter& writer, int elementId,
-    const ElementType& element) {
-  foreach (const QString& locale, element.getAllAvailableLocales()) {
-    writer.addTranslation<ElementType>(elementId, locale,
-                                       element.getNames().tryGet(locale),
-                                       element.getDescriptions().tryGet(locale),
-                                       element.getKeywords().tryGet(locale));
+    const LocalizedNameMap& names, const LocalizedDescriptionMap& descriptions,
+    const LocalizedKeywordsMap& keywords) {
+  QStringList locales;
+  locales.append(names.keys());
+  locales.append(descriptions.keys());
+  locales.append(keywords.keys());
+  locales.removeDuplicates();
+  locales.sort(Qt::CaseSensitive);
+  foreach (const QString& locale, locales) {
+    writer.addTranslation<ElementType>(elementId, locale, names.tryGet(locale),
+                                       descriptions.tryGet(locale),
+                                       keywords.tryGet(locale));
   }
 }
 
 template <typename ElementType>
 void WorkspaceLibraryScanner::addToCategories(WorkspaceLibraryDbWriter& writer,
                                               int elementId,
-                                              const ElementType& element) {
-  foreach (const Uuid& category, element.getCategories()) {
+                                              const QSet<Uuid>& categories) {
+  foreach (const Uuid& category, categories) {
     writer.addToCategory<ElementType>(elementId, category);
   }
 }
 
+template <typename ElementType>
+std::shared_ptr<const typename ElementType::Metadata>
+    WorkspaceLibraryScanner::tryLoadMetadata(const FilePath& fp,
+                                             QString& fingerprint) noexcept {
+  // Note: The fingerprint must be determined *before* loading the element.
+  // If the files are modified while loading (e.g. saved by a library editor),
+  // the stored fingerprint is outdated and the element is scanned again the
+  // next time, instead of storing outdated metadata with a new fingerprint.
+  try {
+    fingerprint = getFingerprint(fp);
+    std::shared_ptr<const typename ElementType::Metadata> metadata =
+        LibraryBaseElement::loadMetadata<ElementType>(
+            TransactionalDirectory(TransactionalFileSystem::openRO(fp)));
+    if (!metadata) {
+      // A file format migration is required, which is only possible by
+      // opening the whole element. Afterwards the metadata can be loaded.
+      // The migration modified the files, thus update the fingerprint.
+      openAndMigrate<ElementType>(fp);  // can throw
+      fingerprint = getFingerprint(fp);
+      metadata = LibraryBaseElement::loadMetadata<ElementType>(
+          TransactionalDirectory(TransactionalFileSystem::openRO(fp)));
+      if (!metadata) throw LogicError(__FILE__, __LINE__);
+    }
+    return metadata;
+  } catch (const Exception& e) {
+    qWarning() << "Failed to open library element during scan:"
+               << fp.toNative();
+    return nullptr;
+  }
+}
+
 template <typename ElementType>
 std::unique_ptr<ElementType> WorkspaceLibraryScanner::openAndMigrate(
     const FilePath& fp) {
@@ -395,6 +515,29 @@ std::unique_ptr<ElementType> WorkspaceLibraryScanner::openAndMigrate(
   return element;
 }
 
+QString WorkspaceLibraryScanner::getFingerprint(const FilePath& dir) noexcept {
+  // Note: The lock file is ignored since it is created and removed whenever
+  // the element is opened in an editor, without modifying the element.
+  QStringList entries;
+  QDirIterator it(dir.toStr(), QDir::Files | QDir::Hidden | QDir::System,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    const QFileInfo info = it.fileInfo();
+    if (info.fileName() != ".lock") {
+      entries.append(QString("%1\t%2\t%3")
+                         .arg(FilePath(info.filePath()).toRelative(dir))
+                         .arg(info.size())
+                         .arg(info.lastModified().toMSecsSinceEpoch()));
+    }
+  }
+  entries.sort();
+  return QString::fromLatin1(
+      QCryptographicHash::hash(entries.join("\n").toUtf8(),
+                               QCryptographicHash::Sha1)
+          .toHex());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -24,6 +24,8 @@
  *  Includes
  ******************************************************************************/
 #include "../fileio/filepath.h"
+#include "../serialization/serializablekeyvaluemap.h"
+#include "../types/uuid.h"
 
 #include <QtCore>
 
@@ -45,6 +47,17 @@ class WorkspaceLibraryDbWriter;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
+ * Scans all workspace libraries and updates the library database accordingly.
+ * To avoid parsing every library element on each scan, a fingerprint of each
+ * element directory (file names, sizes and modification times) is stored in
+ * the database. Only elements whose fingerprint has changed since the last
+ * scan are opened again, and database entries of removed elements are deleted.
+ *
+ * Of modified elements, only the metadata is loaded (see
+ * ::librepcb::LibraryBaseElement::loadMetadata()). This happens in parallel
+ * on the global thread pool, while the database is written by the scanner
+ * thread only, since SQLite connections must not be shared between threads.
+ *
  * @warning Be very careful with dependencies to other objects as the #run()
  * method is executed in a separate thread! Keep the number of dependencies as
  * small as possible and consider thread synchronization and object lifetimes.
@@ -77,6 +90,14 @@ signals:
   void scanFailed(QString errorMsg);
   void scanFinished();
 
+private:  // Types
+  struct ElementState {
+    int id;
+    int libId;
+    QString fingerprint;
+  };
+  typedef QHash<FilePath, ElementState> ElementStates;
+
 private:  // Methods
   void run() noexcept override;
   void scan() noexcept;
@@ -87,19 +108,33 @@ private:  // Methods
       SQLiteDatabase& db, WorkspaceLibraryDbWriter& writer,
       const QList<std::shared_ptr<Library>>& libs);
   template <typename ElementType>
+  ElementStates getElementStates(SQLiteDatabase& db);
+  template <typename ElementType>
   int addElementsToDb(WorkspaceLibraryDbWriter& writer, const FilePath& libPath,
-                      const QStringList& dirs, int libId);
+                      const QStringList& dirs, int libId,
+                      ElementStates& states);
+  template <typename ElementType>
+  void removeElementsFromDb(WorkspaceLibraryDbWriter& writer,
+                            const ElementStates& states);
   template <typename ElementType>
   int addElementToDb(WorkspaceLibraryDbWriter& writer, int libId,
-                     const ElementType& element);
+                     const FilePath& fp,
+                     const typename ElementType::Metadata& metadata,
+                     const QString& fingerprint);
   template <typename ElementType>
   void addTranslationsToDb(WorkspaceLibraryDbWriter& writer, int elementId,
-                           const ElementType& element);
+                           const LocalizedNameMap& names,
+                           const LocalizedDescriptionMap& descriptions,
+                           const LocalizedKeywordsMap& keywords);
   template <typename ElementType>
   void addToCategories(WorkspaceLibraryDbWriter& writer, int elementId,
-                       const ElementType& element);
+                       const QSet<Uuid>& categories);
+  template <typename ElementType>
+  std::shared_ptr<const typename ElementType::Metadata> tryLoadMetadata(
+      const FilePath& fp, QString& fingerprint) noexcept;
   template <typename ElementType>
   std::unique_ptr<ElementType> openAndMigrate(const FilePath& fp);
+  static QString getFingerprint(const FilePath& dir) noexcept;
 
 private:  // Data
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
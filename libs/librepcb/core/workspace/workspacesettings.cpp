@@ -51,6 +51,7 @@ WorkspaceSettings::WorkspaceSettings(QObject* parent)
     useOpenGl("use_opengl", false, this),
     libraryLocaleOrder("library_locale_order", "locale", QStringList(), this),
     libraryNormOrder("library_norm_order", "norm", QStringList(), this),
+    libraryElementCacheSizeMb("library_element_cache_size", 50U, this),
     apiEndpoints("api_endpoints", "url",
                  QList<QUrl>{QUrl("https://api.librepcb.org")}, this),
     externalWebBrowserCommands("external_web_browser", "command", QStringList(),
@@ -198,6 +198,16 @@ public:
    */
   WorkspaceSettingsItem_GenericValueList<QStringList> libraryNormOrder;
 
+  /**
+   * @brief Memory budget of the library element cache [MB]
+   *
+   * Maximum total file size of the library elements kept in memory by the
+   * editor to open dialogs faster.
+   *
+   * Default: 50
+   */
+  WorkspaceSettingsItem_GenericValue<uint> libraryElementCacheSizeMb;
+
   /**
    * @brief The list of API endpoint URLs in the right order
    *
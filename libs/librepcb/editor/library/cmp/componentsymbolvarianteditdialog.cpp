@@ -60,7 +60,7 @@ ComponentSymbolVariantEditDialog::ComponentSymbolVariantEditDialog(
     mOriginalSymbVar(symbVar),
     mSymbVar(*symbVar),
     mGraphicsScene(new GraphicsScene()),
-    mLibraryElementCache(new LibraryElementCache(ws.getLibraryDb())),
+    mLibraryElementCache(LibraryElementCache::getShared(ws.getLibraryDb())),
     mUi(new Ui::ComponentSymbolVariantEditDialog),
     mPreviewUpdateScheduled(false),
     mPreviewTextsUpdateScheduled(false) {
@@ -33,6 +33,7 @@
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -45,11 +46,31 @@ namespace editor {
  *  Constructors / Destructor
  ******************************************************************************/
 
-LibraryElementCache::LibraryElementCache(const WorkspaceLibraryDb& db) noexcept
-  : mDb(&db) {
+LibraryElementCache::LibraryElementCache(const WorkspaceLibraryDb& db,
+                                         int memoryBudget) noexcept
+  : mDb(&db),
+    mScanSucceededConnection(),
+    mCache(memoryBudget),
+    mPrefetches(),
+    mDiscardedPrefetches() {
+  // Any element might have been modified if the library has been rescanned.
+  mScanSucceededConnection =
+      QObject::connect(&db, &WorkspaceLibraryDb::scanSucceeded,
+                       [this](int elementCount) {
+                         Q_UNUSED(elementCount);
+                         clear();
+                       });
 }
 
 LibraryElementCache::~LibraryElementCache() noexcept {
+  QObject::disconnect(mScanSucceededConnection);
+
+  // Wait until all prefetches are finished to release the loaded elements in
+  // this thread.
+  clear();
+  foreach (QFuture<Entry> future, mDiscardedPrefetches) {
+    future.waitForFinished();
+  }
 }
 
 /*******************************************************************************
@@ -58,32 +79,105 @@ LibraryElementCache::~LibraryElementCache() noexcept {
 
 std::shared_ptr<const ComponentCategory>
     LibraryElementCache::getComponentCategory(const Uuid& uuid) const noexcept {
-  return getElement(mCmpCat, uuid);
+  return getLatestElement<ComponentCategory>(uuid);
 }
 
 std::shared_ptr<const PackageCategory> LibraryElementCache::getPackageCategory(
     const Uuid& uuid) const noexcept {
-  return getElement(mPkgCat, uuid);
+  return getLatestElement<PackageCategory>(uuid);
 }
 
 std::shared_ptr<const Symbol> LibraryElementCache::getSymbol(
     const Uuid& uuid) const noexcept {
-  return getElement(mSym, uuid);
+  return getLatestElement<Symbol>(uuid);
 }
 
 std::shared_ptr<const Package> LibraryElementCache::getPackage(
     const Uuid& uuid) const noexcept {
-  return getElement(mPkg, uuid);
+  return getLatestElement<Package>(uuid);
 }
 
 std::shared_ptr<const Component> LibraryElementCache::getComponent(
     const Uuid& uuid) const noexcept {
-  return getElement(mCmp, uuid);
+  return getLatestElement<Component>(uuid);
 }
 
 std::shared_ptr<const Device> LibraryElementCache::getDevice(
     const Uuid& uuid) const noexcept {
-  return getElement(mDev, uuid);
+  return getLatestElement<Device>(uuid);
+}
+
+template <typename T>
+std::shared_ptr<const T> LibraryElementCache::getElement(
+    const FilePath& fp) const {
+  takeFinishedPrefetches();
+  if (const Entry* entry = mCache.object(fp)) {
+    return std::static_pointer_cast<const T>(entry->element);
+  }
+  Entry entry;
+  auto it = mPrefetches.find(fp);
+  if (it != mPrefetches.end()) {
+    // Wait until the element is loaded. If this failed, load it again to
+    // get the exception.
+    entry = it->result();
+    mPrefetches.erase(it);
+  }
+  if (!entry.element) {
+    entry = load<T>(fp, QThread::currentThread());  // can throw
+  }
+  insert(fp, entry);
+  return std::static_pointer_cast<const T>(entry.element);
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void LibraryElementCache::setMemoryBudget(int kilobytes) noexcept {
+  mCache.setMaxCost(kilobytes);
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+template <typename T>
+void LibraryElementCache::prefetch(const QList<FilePath>& fps) const noexcept {
+  takeFinishedPrefetches();
+  QThread* thread = QThread::currentThread();
+  foreach (const FilePath& fp, fps) {
+    if (fp.isValid() && (!mCache.contains(fp)) &&
+        (!mPrefetches.contains(fp))) {
+      mPrefetches.insert(fp, QtConcurrent::run([fp, thread]() {
+                           try {
+                             return load<T>(fp, thread);
+                           } catch (const Exception&) {
+                             return Entry{nullptr, 0};
+                           }
+                         }));
+    }
+  }
+}
+
+void LibraryElementCache::clear() noexcept {
+  mCache.clear();
+  // Note: The futures of running prefetches must be kept until they are
+  // finished, otherwise the loaded elements would be released in a worker
+  // thread even though they belong to this thread.
+  mDiscardedPrefetches.append(mPrefetches.values());
+  mPrefetches.clear();
+}
+
+std::shared_ptr<LibraryElementCache> LibraryElementCache::getShared(
+    const WorkspaceLibraryDb& db) noexcept {
+  static QHash<const WorkspaceLibraryDb*, std::weak_ptr<LibraryElementCache>>
+      instances;
+  std::shared_ptr<LibraryElementCache> cache = instances.value(&db).lock();
+  if ((!cache) || (cache->mDb != &db)) {
+    cache = std::make_shared<LibraryElementCache>(db);
+    instances.insert(&db, cache);
+  }
+  return cache;
 }
 
 /*******************************************************************************
@@ -91,25 +185,94 @@ std::shared_ptr<const Device> LibraryElementCache::getDevice(
  ******************************************************************************/
 
 template <typename T>
-std::shared_ptr<const T> LibraryElementCache::getElement(
-    QHash<Uuid, std::shared_ptr<const T>>& container,
+std::shared_ptr<const T> LibraryElementCache::getLatestElement(
     const Uuid& uuid) const noexcept {
-  std::shared_ptr<const T> element = container.value(uuid);
-  if ((!element) && mDb) {
+  if (mDb) {
     try {
-      FilePath fp = mDb->getLatest<T>(uuid);
-      element.reset(T::open(std::unique_ptr<TransactionalDirectory>(
-                                new TransactionalDirectory(
-                                    TransactionalFileSystem::openRO(fp))))
-                        .release());
-      container.insert(uuid, element);
+      const FilePath fp = mDb->getLatest<T>(uuid);  // can throw
+      if (fp.isValid()) {
+        return getElement<T>(fp);  // can throw
+      }
     } catch (const Exception& e) {
       qWarning() << "Failed to open library element:" << e.getMsg();
     }
   }
-  return element;
+  return nullptr;
+}
+
+void LibraryElementCache::takeFinishedPrefetches() const noexcept {
+  for (auto it = mDiscardedPrefetches.begin();
+       it != mDiscardedPrefetches.end();) {
+    if (it->isFinished()) {
+      it = mDiscardedPrefetches.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = mPrefetches.begin(); it != mPrefetches.end();) {
+    if (it->isFinished()) {
+      const Entry entry = it->result();
+      if (entry.element) {
+        insert(it.key(), entry);
+      }
+      it = mPrefetches.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
+void LibraryElementCache::insert(const FilePath& fp,
+                                 const Entry& entry) const noexcept {
+  // Note: If the element is larger than the whole budget, it is not cached.
+  mCache.insert(fp, new Entry(entry), entry.cost);
+}
+
+template <typename T>
+LibraryElementCache::Entry LibraryElementCache::load(const FilePath& fp,
+                                                     QThread* thread) {
+  std::shared_ptr<T> element(
+      T::open(std::unique_ptr<TransactionalDirectory>(
+                  new TransactionalDirectory(
+                      TransactionalFileSystem::openRO(fp))))  // can throw
+          .release());
+  // Elements might be loaded in a worker thread, but are used in the thread
+  // which owns the cache.
+  if (element->thread() != thread) {
+    element->moveToThread(thread);
+  }
+  const qint64 fileSize =
+      QFileInfo(fp.getPathTo(T::getLongElementName() % ".lp").toStr()).size();
+  return Entry{element, static_cast<int>(qBound(qint64(1), fileSize / 1024,
+                                                qint64(INT_MAX)))};
+}
+
+/*******************************************************************************
+ *  Explicit Template Instantiations
+ ******************************************************************************/
+
+template std::shared_ptr<const ComponentCategory>
+    LibraryElementCache::getElement<ComponentCategory>(const FilePath&) const;
+template std::shared_ptr<const PackageCategory>
+    LibraryElementCache::getElement<PackageCategory>(const FilePath&) const;
+template std::shared_ptr<const Symbol>
+    LibraryElementCache::getElement<Symbol>(const FilePath&) const;
+template std::shared_ptr<const Package>
+    LibraryElementCache::getElement<Package>(const FilePath&) const;
+template std::shared_ptr<const Component>
+    LibraryElementCache::getElement<Component>(const FilePath&) const;
+template std::shared_ptr<const Device>
+    LibraryElementCache::getElement<Device>(const FilePath&) const;
+
+template void LibraryElementCache::prefetch<Symbol>(
+    const QList<FilePath>&) const noexcept;
+template void LibraryElementCache::prefetch<Package>(
+    const QList<FilePath>&) const noexcept;
+template void LibraryElementCache::prefetch<Component>(
+    const QList<FilePath>&) const noexcept;
+template void LibraryElementCache::prefetch<Device>(
+    const QList<FilePath>&) const noexcept;
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -38,6 +38,7 @@ namespace librepcb {
 class Component;
 class ComponentCategory;
 class Device;
+class LibraryBaseElement;
 class Package;
 class PackageCategory;
 class Symbol;
@@ -51,6 +52,19 @@ namespace editor {
 
 /**
  * @brief Cache for fast access to library elements
+ *
+ * Loaded elements are kept in a least-recently-used cache with a limited
+ * memory budget. Since the real memory usage of an element is not known, the
+ * size of its main file is used as an estimate. Elements which are likely
+ * needed soon can be loaded in background threads with #prefetch().
+ *
+ * All cached elements are discarded when the workspace library database has
+ * been rescanned, as any element might have been modified.
+ *
+ * Use #getShared() to get an instance shared by all users within the process,
+ * so each element is loaded only once even across several windows.
+ *
+ * @note This class must be used from the GUI thread only.
  */
 class LibraryElementCache final {
   Q_DECLARE_TR_FUNCTIONS(LibraryElementCache)
@@ -59,7 +73,18 @@ public:
   // Constructors / Destructor
   LibraryElementCache() = delete;
   LibraryElementCache(const LibraryElementCache& other) = delete;
-  explicit LibraryElementCache(const WorkspaceLibraryDb& db) noexcept;
+
+  /**
+   * @brief Constructor
+   *
+   * @param db            The workspace library database.
+   * @param memoryBudget  Maximum total size (in kilobytes) of the files of all
+   *                      cached elements. Elements which were not accessed
+   *                      recently are discarded to stay below this limit.
+   */
+  explicit LibraryElementCache(
+      const WorkspaceLibraryDb& db,
+      int memoryBudget = sDefaultMemoryBudget) noexcept;
   ~LibraryElementCache() noexcept;
 
   // Getters
@@ -72,24 +97,93 @@ public:
   std::shared_ptr<const Component> getComponent(
       const Uuid& uuid) const noexcept;
   std::shared_ptr<const Device> getDevice(const Uuid& uuid) const noexcept;
+  int getMemoryBudget() const noexcept { return mCache.maxCost(); }
+
+  /**
+   * @brief Get a library element by its directory
+   *
+   * @tparam T  Type of the library element, e.g. ::librepcb::Device.
+   * @param fp  Directory of the library element.
+   *
+   * @return The loaded element.
+   *
+   * @throw Exception if the element could not be loaded.
+   */
+  template <typename T>
+  std::shared_ptr<const T> getElement(const FilePath& fp) const;
+
+  // Setters
+
+  /**
+   * @brief Set the memory budget
+   *
+   * @param kilobytes   Maximum total size of the files of all cached elements.
+   *                    Elements which were not accessed recently are
+   *                    discarded immediately to stay below this limit.
+   */
+  void setMemoryBudget(int kilobytes) noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Start loading library elements in background threads
+   *
+   * Subsequent calls to #getElement() don't need to load the elements
+   * anymore, or at least need to wait only until they are loaded.
+   *
+   * @tparam T  Type of the library elements, e.g. ::librepcb::Device.
+   * @param fps Directories of the library elements. Elements which are
+   *            already cached or being loaded are skipped.
+   */
+  template <typename T>
+  void prefetch(const QList<FilePath>& fps) const noexcept;
+
+  /**
+   * @brief Discard all cached elements
+   *
+   * Running prefetches can't be aborted, so they are kept until they are
+   * finished and their results are discarded then.
+   */
+  void clear() noexcept;
 
   // Operator Overloadings
   LibraryElementCache& operator=(const LibraryElementCache& rhs) = delete;
 
+  // Static Methods
+
+  /**
+   * @brief Get a cache instance shared within the whole process
+   *
+   * @param db  The workspace library database.
+   *
+   * @return The cache for the passed database. Kept alive as long as at least
+   *         one user holds a reference to it.
+   */
+  static std::shared_ptr<LibraryElementCache> getShared(
+      const WorkspaceLibraryDb& db) noexcept;
+
+private:  // Types
+  struct Entry {
+    std::shared_ptr<const LibraryBaseElement> element;
+    int cost;
+  };
+
 private:  // Methods
   template <typename T>
-  std::shared_ptr<const T> getElement(
-      QHash<Uuid, std::shared_ptr<const T>>& container,
-      const Uuid& uuid) const noexcept;
+  std::shared_ptr<const T> getLatestElement(const Uuid& uuid) const noexcept;
+  void takeFinishedPrefetches() const noexcept;
+  void insert(const FilePath& fp, const Entry& entry) const noexcept;
+  template <typename T>
+  static Entry load(const FilePath& fp, QThread* thread);
 
 private:  // Data
   QPointer<const WorkspaceLibraryDb> mDb;
-  mutable QHash<Uuid, std::shared_ptr<const ComponentCategory>> mCmpCat;
-  mutable QHash<Uuid, std::shared_ptr<const PackageCategory>> mPkgCat;
-  mutable QHash<Uuid, std::shared_ptr<const Symbol>> mSym;
-  mutable QHash<Uuid, std::shared_ptr<const Package>> mPkg;
-  mutable QHash<Uuid, std::shared_ptr<const Component>> mCmp;
-  mutable QHash<Uuid, std::shared_ptr<const Device>> mDev;
+  QMetaObject::Connection mScanSucceededConnection;
+  mutable QCache<FilePath, Entry> mCache;
+  mutable QHash<FilePath, QFuture<Entry>> mPrefetches;
+  mutable QList<QFuture<Entry>> mDiscardedPrefetches;
+
+  static const int sDefaultMemoryBudget = 50 * 1024;  ///< 50 MB of files
 };
 
 /*******************************************************************************
@@ -75,8 +75,7 @@ void NewElementWizardPage_ComponentPinSignalMap::initializePage() noexcept {
   QWizardPage::initializePage();
   mUi->pinSignalMapEditorWidget->setReferences(
       mContext.mComponentSymbolVariants.value(0).get(),
-      std::make_shared<LibraryElementCache>(
-          mContext.getWorkspace().getLibraryDb()),
+      LibraryElementCache::getShared(mContext.getWorkspace().getLibraryDb()),
       &mContext.mComponentSignals, nullptr);
 }
 
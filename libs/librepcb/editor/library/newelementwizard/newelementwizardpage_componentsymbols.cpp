@@ -99,8 +99,7 @@ void NewElementWizardPage_ComponentSymbols::initializePage() noexcept {
   mUi->symbolListEditorWidget->setReferences(
       mContext.getWorkspace(), mContext.getLayerProvider(),
       mContext.mComponentSymbolVariants.value(0)->getSymbolItems(),
-      std::make_shared<LibraryElementCache>(
-          mContext.getWorkspace().getLibraryDb()),
+      LibraryElementCache::getShared(mContext.getWorkspace().getLibraryDb()),
       nullptr);
   mLoadedSymbolUuids = getSymbolUuids();
 }
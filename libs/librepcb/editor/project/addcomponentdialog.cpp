@@ -25,6 +25,7 @@
 #include "../editorcommandset.h"
 #include "../graphics/defaultgraphicslayerprovider.h"
 #include "../graphics/graphicsscene.h"
+#include "../library/libraryelementcache.h"
 #include "../library/pkg/footprintgraphicsitem.h"
 #include "../library/sym/symbolgraphicsitem.h"
 #include "../widgets/graphicsview.h"
@@ -62,6 +63,7 @@ AddComponentDialog::AddComponentDialog(const WorkspaceLibraryDb& db,
                                        const Theme& theme, QWidget* parent)
   : QDialog(parent),
     mDb(db),
+    mLibraryElementCache(LibraryElementCache::getShared(db)),
     mLocaleOrder(localeOrder),
     mNormOrder(normOrder),
     mUi(new Ui::AddComponentDialog),
@@ -266,23 +268,24 @@ void AddComponentDialog::treeComponents_currentItemChanged(
       FilePath cmpFp = FilePath(cmpItem->data(0, Qt::UserRole).toString());
       if ((!mSelectedComponent) ||
           (mSelectedComponent->getDirectory().getAbsPath() != cmpFp)) {
-        std::shared_ptr<Component> component(
-            Component::open(std::unique_ptr<TransactionalDirectory>(
-                                new TransactionalDirectory(
-                                    TransactionalFileSystem::openRO(cmpFp))))
-                .release());
-        setSelectedComponent(component);
+        setSelectedComponent(
+            mLibraryElementCache->getElement<Component>(cmpFp));  // can throw
+
+        // Load the devices in background since they will likely be selected
+        // next.
+        QList<FilePath> devFps;
+        for (int i = 0; i < cmpItem->childCount(); ++i) {
+          devFps.append(
+              FilePath(cmpItem->child(i)->data(0, Qt::UserRole).toString()));
+        }
+        mLibraryElementCache->prefetch<Device>(devFps);
       }
       if (devItem) {
         FilePath devFp = FilePath(devItem->data(0, Qt::UserRole).toString());
         if ((!mSelectedDevice) ||
             (mSelectedDevice->getDirectory().getAbsPath() != devFp)) {
-          std::shared_ptr<Device> device(
-              Device::open(std::unique_ptr<TransactionalDirectory>(
-                               new TransactionalDirectory(
-                                   TransactionalFileSystem::openRO(devFp))))
-                  .release());
-          setSelectedDevice(device);
+          setSelectedDevice(
+              mLibraryElementCache->getElement<Device>(devFp));  // can throw
         }
         setSelectedPart(
             partItem
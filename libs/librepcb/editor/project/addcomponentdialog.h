@@ -54,6 +54,7 @@ namespace editor {
 class DefaultGraphicsLayerProvider;
 class FootprintGraphicsItem;
 class GraphicsScene;
+class LibraryElementCache;
 class SymbolGraphicsItem;
 
 namespace Ui {
@@ -167,6 +168,7 @@ private:
 
   // General
   const WorkspaceLibraryDb& mDb;
+  std::shared_ptr<LibraryElementCache> mLibraryElementCache;
   QStringList mLocaleOrder;
   QStringList mNormOrder;
   QScopedPointer<Ui::AddComponentDialog> mUi;
@@ -1315,10 +1315,16 @@ void BoardEditor::runDrc(bool quick) noexcept {
     mDockDrc->show();
     mDockDrc->raise();
 
-    // Set UI into busy state during the checks.
+    // Set UI into busy state during the checks. Since the checks read the
+    // board from worker threads, neither the plane builder nor any other
+    // periodic task (e.g. autosave) must modify it in the meantime.
     setCursor(Qt::WaitCursor);
     bool wasInteractive = mDockDrc->setInteractive(false);
+    mPlaneFragmentsBuilder->setSuspended(true);
+    mProjectEditor.setBackgroundTasksSuspended(true);
     auto busyScopeGuard = scopeGuard([this, wasInteractive]() {
+      mProjectEditor.setBackgroundTasksSuspended(false);
+      mPlaneFragmentsBuilder->setSuspended(false);
       mDockDrc->setInteractive(wasInteractive);
       unsetCursor();
     });
@@ -1331,7 +1337,7 @@ void BoardEditor::runDrc(bool quick) noexcept {
             &RuleCheckDock::setProgressPercent);
     connect(&drc, &BoardDesignRuleCheck::progressStatus, mDockDrc.data(),
             &RuleCheckDock::setProgressStatus);
-    drc.execute(quick);  // can throw
+    drc.execute(quick, true);  // can throw
 
     // Update DRC messages.
     clearDrcMarker();
@@ -1455,6 +1461,11 @@ void BoardEditor::scheduleOpenGlSceneUpdate() noexcept {
 }
 
 void BoardEditor::performScheduledTasks() noexcept {
+  // Don't access the board while other threads are reading it.
+  if (mProjectEditor.areBackgroundTasksSuspended()) {
+    return;
+  }
+
   const bool commandActive =
       mProjectEditor.getUndoStack().isCommandGroupActive() ||
       mUi->graphicsView->isMouseButtonPressed(Qt::LeftButton |
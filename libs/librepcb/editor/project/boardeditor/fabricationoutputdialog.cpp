@@ -215,7 +215,7 @@ void FabricationOutputDialog::btnGenerateClicked() {
     s.setEnableSolderPasteTop(mUi->cbxSolderPasteTop->isChecked());
     s.setEnableSolderPasteBot(mUi->cbxSolderPasteBot->isChecked());
     if (s != mBoard.getFabricationOutputSettings()) {
-      mBoard.getFabricationOutputSettings() = s;  // TODO: use undo command
+      mBoard.setFabricationOutputSettings(s);  // TODO: use undo command
     }
 
     // generate files
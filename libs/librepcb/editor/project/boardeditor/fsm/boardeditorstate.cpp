@@ -177,6 +177,28 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   const QPainterPath posAreaLarge =
       mContext.editorGraphicsView.calcPosWithTolerance(pos, 1.5);
 
+  // Only consider items close to the cursor to avoid calculating the grab
+  // area of every single item, which is way too slow on large boards. The
+  // graphics scene already maintains a spatial index of all items (updated
+  // whenever an item is moved or modified), so let's use it. Note that it
+  // only returns visible items with contents, so item groups (e.g. pads) are
+  // found through their children.
+  const QRectF posAreaRect = posAreaLarge.boundingRect();
+  const QRectF searchRect =
+      QPolygonF({posAreaRect.topLeft(), posAreaRect.bottomRight(), posOnGrid})
+          .boundingRect();
+  QSet<const QGraphicsItem*> candidates;
+  foreach (const QGraphicsItem* item,
+           scene->items(searchRect, Qt::IntersectsItemBoundingRect)) {
+    for (; item && (!candidates.contains(item)); item = item->parentItem()) {
+      candidates.insert(item);
+    }
+  }
+  auto isCandidate =
+      [&candidates](const std::shared_ptr<QGraphicsItem>& item) {
+        return candidates.contains(item.get());
+      };
+
   // Note: The order of adding the items is very important (the top most item
   // must appear as the first item in the list)! For that, we work with
   // priorities (0 = highest priority):
@@ -290,6 +312,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Holes)) {
     for (auto it = scene->getHoles().begin(); it != scene->getHoles().end();
          it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       processItem(it.value(),
                   it.key()->getData().getPath()->getVertices().first().getPos(),
                   5, false);
@@ -299,6 +324,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Vias)) {
     for (auto it = scene->getVias().begin(); it != scene->getVias().end();
          it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
         if ((!cuLayer) || (it.key()->getVia().isOnLayer(*cuLayer))) {
@@ -311,6 +339,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::NetPoints)) {
     for (auto it = scene->getNetPoints().begin();
          it != scene->getNetPoints().end(); it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
         const Layer* layer = it.key()->getLayerOfTraces();
@@ -325,6 +356,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::NetLines)) {
     for (auto it = scene->getNetLines().begin();
          it != scene->getNetLines().end(); it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
         const Layer& layer = it.key()->getLayer();
@@ -343,6 +377,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Planes)) {
     for (auto it = scene->getPlanes().begin(); it != scene->getPlanes().end();
          it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getNetSignal())) {
         if ((!cuLayer) || (*cuLayer == it.key()->getLayer())) {
@@ -359,6 +396,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Zones)) {
     for (auto it = scene->getZones().begin(); it != scene->getZones().end();
          it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       if ((!cuLayer) || (it.key()->getData().getLayers().contains(&*cuLayer))) {
         QList<const Layer*> layers = it.key()->getData().getLayers().toList();
         std::sort(layers.begin(), layers.end(), &Layer::lessThan);
@@ -379,6 +419,14 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Devices)) {
     for (auto it = scene->getDevices().begin(); it != scene->getDevices().end();
          it++) {
+      // The grab area of devices is not covered by their children if the
+      // layers of the children are hidden, so check the bounding rect of all
+      // children instead.
+      const QRectF rect = it.value()->mapRectToScene(
+          it.value()->childrenBoundingRect());
+      if (!rect.intersects(searchRect)) {
+        continue;
+      }
       processItem(it.value(), it.key()->getPosition(),
                   40 + (it.key()->getMirrored() ? 300 : 100), false);
     }
@@ -387,6 +435,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::FootprintPads)) {
     for (auto it = scene->getFootprintPads().begin();
          it != scene->getFootprintPads().end(); it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getCompSigInstNetSignal())) {
         if ((!cuLayer) || (it.key()->isOnLayer(*cuLayer))) {
@@ -404,6 +455,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Polygons)) {
     for (auto it = scene->getPolygons().begin();
          it != scene->getPolygons().end(); it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       processItem(
           it.value(),
           it.key()->getData().getPath().calcNearestPointBetweenVertices(pos),
@@ -415,6 +469,9 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::StrokeTexts)) {
     for (auto it = scene->getStrokeTexts().begin();
          it != scene->getStrokeTexts().end(); it++) {
+      if (!isCandidate(it.value())) {
+        continue;
+      }
       processItem(it.value(), it.key()->getData().getPosition(),
                   60 + priorityFromLayer(it.key()->getData().getLayer()),
                   false);
@@ -58,7 +58,11 @@ ProjectEditor::ProjectEditor(
     mSchematicEditor(nullptr),
     mBoardEditor(nullptr),
     mLastAutosaveStateId(0),
-    mManualModificationsMade(false) {
+    mAutosaveStateId(0),
+    mAutosaveRetryPending(false),
+    mManualModificationsMade(false),
+    mBackgroundTasksSuspended(false),
+    mErcPending(false) {
   try {
     if (upgradeMessages) {
       mUpgradeMessages = *upgradeMessages;
@@ -105,6 +109,16 @@ ProjectEditor::ProjectEditor(
     // autosaving is enabled --> start the timer
     connect(&mAutoSaveTimer, &QTimer::timeout, this,
             &ProjectEditor::autosaveProject);
+    connect(&mAutosaveWatcher, &QFutureWatcher<bool>::finished, this, [this]() {
+      if (mAutosaveWatcher.result()) {
+        mLastAutosaveStateId = mAutosaveStateId;
+        qDebug() << "Successfully autosaved project.";
+      }
+      if (mAutosaveRetryPending) {
+        mAutosaveRetryPending = false;
+        autosaveProject();
+      }
+    });
     mAutoSaveTimer.start(1000 * intervalSecs);
   }
 }
@@ -328,6 +342,7 @@ bool ProjectEditor::saveProject() noexcept {
     mProject.save();  // can throw
     mProject.getDirectory().getFileSystem()->save();  // can throw
     mLastAutosaveStateId = mUndoStack->getUniqueStateId();
+    mAutosaveStateId = mLastAutosaveStateId;  // Running autosave is outdated.
     mManualModificationsMade = false;
 
     // saving was successful --> clean the undo stack
@@ -359,13 +374,23 @@ bool ProjectEditor::autosaveProject() noexcept {
     return false;
   }
 
+  if (mAutosaveWatcher.isRunning() || mBackgroundTasksSuspended) {
+    // the last autosave backup is still being written or the project must not
+    // be modified at the moment, try it again as soon as possible (only once,
+    // even if the timer fires several times)
+    mAutosaveRetryPending = true;
+    return false;
+  }
+
   try {
     qDebug() << "Autosave project...";
     emit projectAboutToBeSaved();
     mProject.save();  // can throw
-    mProject.getDirectory().getFileSystem()->autosave();  // can throw
-    mLastAutosaveStateId = mUndoStack->getUniqueStateId();
-    qDebug() << "Successfully autosaved project.";
+    // The backup is written to disk in a background thread, so the GUI is not
+    // blocked by the disk I/O.
+    mAutosaveStateId = mUndoStack->getUniqueStateId();
+    mAutosaveWatcher.setFuture(
+        mProject.getDirectory().getFileSystem()->startAutosave());  // can throw
     return true;
   } catch (Exception& exc) {
     return false;
@@ -420,6 +445,24 @@ void ProjectEditor::setErcMessageApproved(const RuleCheckMessage& msg,
   saveErcMessageApprovals(approvals);
 }
 
+void ProjectEditor::setBackgroundTasksSuspended(bool suspended) noexcept {
+  if (suspended == mBackgroundTasksSuspended) {
+    return;
+  }
+
+  mBackgroundTasksSuspended = suspended;
+  if (!suspended) {
+    if (mErcPending) {
+      mErcPending = false;
+      runErc();
+    }
+    if (mAutosaveRetryPending && (!mAutosaveWatcher.isRunning())) {
+      mAutosaveRetryPending = false;
+      autosaveProject();
+    }
+  }
+}
+
 void ProjectEditor::setHighlightedNetSignals(
     const QSet<const NetSignal*>& netSignals) noexcept {
   if (netSignals != *mHighlightedNetSignals) {
@@ -437,6 +480,13 @@ void ProjectEditor::clearHighlightedNetSignals() noexcept {
  ******************************************************************************/
 
 void ProjectEditor::runErc() noexcept {
+  // Don't run the ERC while suspended since it updates the message approvals
+  // of the project, it will be triggered again when resumed.
+  if (mBackgroundTasksSuspended) {
+    mErcPending = true;
+    return;
+  }
+
   try {
     QElapsedTimer timer;
     timer.start();
@@ -188,9 +188,12 @@ public slots:
   /**
    * @brief Make a automatic backup of the project (save to temporary files)
    *
+   * The project is serialized immediately, but the backup is written to disk
+   * in a background thread.
+   *
    * @note The whole save procedere is described in @ref doc_project_save.
    *
-   * @return true on success, false on failure
+   * @return true if the backup was started, false on failure
    */
   bool autosaveProject() noexcept;
 
@@ -229,6 +232,29 @@ public slots:
     mManualModificationsMade = true;
   }
 
+  /**
+   * @brief Check whether periodic background tasks are suspended
+   *
+   * @return Whether suspended or not.
+   *
+   * @see #setBackgroundTasksSuspended()
+   */
+  bool areBackgroundTasksSuspended() const noexcept {
+    return mBackgroundTasksSuspended;
+  }
+
+  /**
+   * @brief Suspend or resume periodic background tasks
+   *
+   * While suspended, neither the autosave nor the ERC is executed since they
+   * modify the project. Tasks requested in the meantime are executed after
+   * getting resumed. This allows other threads to safely read the project
+   * (e.g. the board during a DRC).
+   *
+   * @param suspended   Whether to suspend or resume.
+   */
+  void setBackgroundTasksSuspended(bool suspended) noexcept;
+
   /**
    * @brief Approve/unapprove an ERC message
    *
@@ -283,8 +309,23 @@ private:  // Data
   /// The UndoStack state ID of the last successful project (auto)save
   uint mLastAutosaveStateId;
 
+  /// The autosave backup currently written in a background thread
+  QFutureWatcher<bool> mAutosaveWatcher;
+
+  /// The UndoStack state ID of the autosave backup currently being written
+  uint mAutosaveStateId;
+
+  /// Whether to autosave again once the running autosave is finished
+  bool mAutosaveRetryPending;
+
   /// Modifications bypassing the undo stack
   bool mManualModificationsMade;
+
+  /// See #setBackgroundTasksSuspended()
+  bool mBackgroundTasksSuspended;
+
+  /// Whether to run the ERC once the background tasks are resumed
+  bool mErcPending;
 };
 
 /*******************************************************************************
@@ -26,6 +26,7 @@
 #include "../../dialogs/filedialog.h"
 #include "../../editorcommandset.h"
 #include "../../library/libraryeditor.h"
+#include "../../library/libraryelementcache.h"
 #include "../../project/newprojectwizard/newprojectwizard.h"
 #include "../../project/projecteditor.h"
 #include "../../utils/menubuilder.h"
@@ -51,6 +52,7 @@
 #include <librepcb/core/utils/scopeguard.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/core/workspace/workspacesettings.h>
 #include <librepcb_build_env.h>
 
 #include <QtCore>
@@ -78,7 +80,9 @@ ControlPanel::ControlPanel(Workspace& workspace, bool fileFormatIsOutdated)
     mUi(new Ui::ControlPanel),
     mStandardCommandHandler(
         new StandardEditorCommandHandler(mWorkspace.getSettings(), this)),
-    mLibraryManager(new LibraryManager(mWorkspace, this)) {
+    mLibraryManager(new LibraryManager(mWorkspace, this)),
+    mLibraryElementCache(
+        LibraryElementCache::getShared(mWorkspace.getLibraryDb())) {
   mUi->setupUi(this);
   setWindowTitle(
       tr("Control Panel - LibrePCB %1").arg(Application::getVersion()));
@@ -94,6 +98,19 @@ ControlPanel::ControlPanel(Workspace& workspace, bool fileFormatIsOutdated)
   mUi->statusBar->setProgressBarPercent(
       mWorkspace.getLibraryDb().getScanProgressPercent());
 
+  // The library element cache is shared by all editors of this workspace and
+  // kept alive as long as the control panel exists. Apply the configured
+  // memory budget, also when it is modified.
+  auto updateLibraryElementCacheSize = [this]() {
+    const uint megabytes =
+        mWorkspace.getSettings().libraryElementCacheSizeMb.get();
+    mLibraryElementCache->setMemoryBudget(
+        static_cast<int>(qMin(megabytes, uint(INT_MAX / 1024))) * 1024);
+  };
+  updateLibraryElementCacheSize();
+  connect(&mWorkspace.getSettings().libraryElementCacheSizeMb,
+          &WorkspaceSettingsItem::edited, this, updateLibraryElementCacheSize);
+
   // Setup actions and menus.
   createActions();
   createMenus();
@@ -28,6 +28,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -42,6 +44,7 @@ namespace editor {
 
 class FavoriteProjectsModel;
 class LibraryEditor;
+class LibraryElementCache;
 class LibraryManager;
 class ProjectEditor;
 class ProjectLibraryUpdater;
@@ -209,6 +212,7 @@ private:
   QScopedPointer<RecentProjectsModel> mRecentProjectsModel;
   QScopedPointer<FavoriteProjectsModel> mFavoriteProjectsModel;
   QScopedPointer<LibraryManager> mLibraryManager;
+  std::shared_ptr<LibraryElementCache> mLibraryElementCache;
   QHash<QString, ProjectEditor*> mOpenProjectEditors;
   QHash<FilePath, LibraryEditor*> mOpenLibraryEditors;
   QScopedPointer<ProjectLibraryUpdater> mProjectLibraryUpdater;
@@ -674,6 +674,10 @@ void WorkspaceSettingsDialog::loadSettings() noexcept {
   // Library Norm Order
   mLibNormOrderModel->setValues(mSettings.libraryNormOrder.get());
 
+  // Library Element Cache Size
+  mUi->spbLibraryElementCacheSize->setValue(
+      mSettings.libraryElementCacheSizeMb.get());
+
   // API endpoints
   mApiEndpointModel->setValues(mSettings.apiEndpoints.get());
 
@@ -723,6 +727,10 @@ void WorkspaceSettingsDialog::saveSettings() noexcept {
     // Library Norm Order
     mSettings.libraryNormOrder.set(mLibNormOrderModel->getValues());
 
+    // Library Element Cache Size
+    mSettings.libraryElementCacheSizeMb.set(
+        mUi->spbLibraryElementCacheSize->value());
+
     // API endpoints
     mSettings.apiEndpoints.set(mApiEndpointModel->getValues());
 
@@ -0,0 +1,162 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/cat/componentcategory.h>
+#include <librepcb/core/library/cat/packagecategory.h>
+#include <librepcb/core/library/cmp/component.h>
+#include <librepcb/core/library/dev/device.h>
+#include <librepcb/core/library/library.h>
+#include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/library/sym/symbol.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+/**
+ * @brief Measures opening library elements, with and without file format
+ *        migration
+ *
+ * Uses all elements of the legacy library in the test data directory. To
+ * measure opening without migration, an upgraded copy of that library is
+ * created in a temporary directory. The migration is done in memory only.
+ */
+class LibraryElementBenchmark : public ::benchmark::Fixture {
+public:
+  void SetUp(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    mLegacyDir = FilePath(TEST_DATA_DIR "/libraries/v0.1.lplib");
+    mUpgradedDir = FilePath::getRandomTempPath();
+    FileUtils::copyDirRecursively(mLegacyDir, mUpgradedDir);  // can throw
+
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(mUpgradedDir);
+    std::unique_ptr<Library> lib = Library::open(createDir(fs));  // can throw
+    lib->save();  // can throw
+    mDirs[0] = upgradeElements<ComponentCategory>(fs, *lib);  // can throw
+    mDirs[1] = upgradeElements<PackageCategory>(fs, *lib);  // can throw
+    mDirs[2] = upgradeElements<Symbol>(fs, *lib);  // can throw
+    mDirs[3] = upgradeElements<Package>(fs, *lib);  // can throw
+    mDirs[4] = upgradeElements<Component>(fs, *lib);  // can throw
+    mDirs[5] = upgradeElements<Device>(fs, *lib);  // can throw
+    fs->save();  // can throw
+    mElementCount = 0;
+    for (const QStringList& dirs : mDirs) {
+      mElementCount += dirs.count();
+    }
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    QDir(mUpgradedDir.toStr()).removeRecursively();
+    for (QStringList& dirs : mDirs) {
+      dirs.clear();
+    }
+    mElementCount = 0;
+  }
+
+protected:
+  static std::unique_ptr<TransactionalDirectory> createDir(
+      const std::shared_ptr<TransactionalFileSystem>& fs,
+      const QString& path = QString()) noexcept {
+    return std::unique_ptr<TransactionalDirectory>(
+        new TransactionalDirectory(fs, path));
+  }
+
+  template <typename ElementType>
+  static QStringList upgradeElements(
+      const std::shared_ptr<TransactionalFileSystem>& fs, const Library& lib) {
+    const QStringList dirs = lib.searchForElements<ElementType>();
+    foreach (const QString& dir, dirs) {
+      std::unique_ptr<ElementType> element =
+          ElementType::open(createDir(fs, dir));  // can throw
+      element->save();  // can throw
+    }
+    return dirs;
+  }
+
+  template <typename ElementType>
+  static void openElements(const std::shared_ptr<TransactionalFileSystem>& fs,
+                           const QStringList& dirs) {
+    foreach (const QString& dir, dirs) {
+      ::benchmark::DoNotOptimize(
+          ElementType::open(createDir(fs, dir)));  // can throw
+    }
+  }
+
+  void openAllElements(const FilePath& libDir) const {
+    // A new file system is needed in each run since the file system keeps
+    // the migrated files in memory.
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRO(libDir);
+    openElements<ComponentCategory>(fs, mDirs[0]);  // can throw
+    openElements<PackageCategory>(fs, mDirs[1]);  // can throw
+    openElements<Symbol>(fs, mDirs[2]);  // can throw
+    openElements<Package>(fs, mDirs[3]);  // can throw
+    openElements<Component>(fs, mDirs[4]);  // can throw
+    openElements<Device>(fs, mDirs[5]);  // can throw
+  }
+
+  FilePath mLegacyDir;
+  FilePath mUpgradedDir;
+  QStringList mDirs[6];  ///< Element directories, ordered by type
+  int mElementCount = 0;
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+BENCHMARK_F(LibraryElementBenchmark, Open)(::benchmark::State& state) {
+  for (auto _ : state) {
+    openAllElements(mUpgradedDir);
+  }
+  state.counters["elements"] = ::benchmark::Counter(
+      mElementCount, ::benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_F(LibraryElementBenchmark, OpenAndMigrate)
+(::benchmark::State& state) {
+  for (auto _ : state) {
+    openAllElements(mLegacyDir);
+  }
+  state.counters["elements"] = ::benchmark::Counter(
+      mElementCount, ::benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,174 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/via.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardairwiresbuilder.h>
+#include <librepcb/core/project/board/boardplanefragmentsbuilder.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/board/items/bi_plane.h>
+#include <librepcb/core/project/board/items/bi_via.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/types/layer.h>
+
+#include <QtCore>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+/**
+ * @brief Compares a full airwires rebuild with an incremental update
+ *
+ * Opens a project containing planes and adds a configurable number of vias
+ * to the net of the first plane, i.e. simulates a large GND net. Then one via
+ * is moved back and forth, like when dragging an item in the board editor.
+ */
+class BoardAirWiresBuilderBenchmark : public ::benchmark::Fixture {
+public:
+  void SetUp(const ::benchmark::State& state) override {
+    FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    ProjectLoader loader;
+    mProject = loader.open(std::unique_ptr<TransactionalDirectory>(
+                               new TransactionalDirectory(projectFs)),
+                           projectFp.getFilename());  // can throw
+    mBoard = mProject->getBoards().first();
+    mNetSignal = mBoard->getPlanes().first()->getNetSignal();
+    Q_ASSERT(mNetSignal);
+
+    // Add vias in a grid within the board area.
+    const int count = state.range(0);
+    const int columns = std::ceil(std::sqrt(count));
+    const auto rect = mBoard->calculateBoundingRect();
+    const Point origin = rect ? rect->first : Point(0, 0);
+    const Point size = rect ? (rect->second - rect->first)
+                            : Point(100000000, 100000000);
+    BI_NetSegment* segment =
+        new BI_NetSegment(*mBoard, Uuid::createRandom(), mNetSignal);
+    mBoard->addNetSegment(*segment);  // can throw
+    QList<BI_Via*> vias;
+    for (int i = 0; i < count; ++i) {
+      const Point pos = origin +
+          Point(size.getX() * ((i % columns) + 1) / (columns + 1),
+                size.getY() * ((i / columns) + 1) / (columns + 1));
+      vias.append(new BI_Via(
+          *segment,
+          Via(Uuid::createRandom(), Layer::topCopper(), Layer::botCopper(),
+              pos, PositiveLength(500000), PositiveLength(300000),
+              MaskConfig::off())));
+    }
+    segment->addElements(vias, {}, {});  // can throw
+    mMovedVia = vias.first();
+
+    BoardPlaneFragmentsBuilder planeBuilder;
+    planeBuilder.runSynchronously(*mBoard);  // can throw
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    mMovedVia = nullptr;
+    mNetSignal = nullptr;
+    mBoard = nullptr;
+    mProject.reset();
+  }
+
+protected:
+  void moveVia() noexcept {
+    const Length offset = mMoved ? Length(-100000) : Length(100000);
+    mMovedVia->setPosition(mMovedVia->getPosition() + Point(offset, 0));
+    mMoved = !mMoved;
+  }
+
+  std::unique_ptr<Project> mProject;
+  Board* mBoard = nullptr;
+  NetSignal* mNetSignal = nullptr;
+  BI_Via* mMovedVia = nullptr;
+  bool mMoved = false;
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+BENCHMARK_DEFINE_F(BoardAirWiresBuilderBenchmark, FullRebuild)
+(::benchmark::State& state) {
+  for (auto _ : state) {
+    moveVia();
+    BoardAirWiresBuilder builder(*mBoard, *mNetSignal);
+    ::benchmark::DoNotOptimize(builder.buildAirWires());
+  }
+}
+
+BENCHMARK_DEFINE_F(BoardAirWiresBuilderBenchmark, IncrementalMove)
+(::benchmark::State& state) {
+  BoardAirWiresBuilder builder(*mBoard, *mNetSignal);
+  builder.buildAirWires();
+  for (auto _ : state) {
+    moveVia();
+    ::benchmark::DoNotOptimize(builder.buildAirWires());
+  }
+}
+
+BENCHMARK_DEFINE_F(BoardAirWiresBuilderBenchmark, IncrementalUnmodified)
+(::benchmark::State& state) {
+  BoardAirWiresBuilder builder(*mBoard, *mNetSignal);
+  builder.buildAirWires();
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(builder.buildAirWires());
+  }
+}
+
+BENCHMARK_REGISTER_F(BoardAirWiresBuilderBenchmark, FullRebuild)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(2000)
+    ->Unit(::benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(BoardAirWiresBuilderBenchmark, IncrementalMove)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(2000)
+    ->Unit(::benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(BoardAirWiresBuilderBenchmark, IncrementalUnmodified)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(2000)
+    ->Unit(::benchmark::kMicrosecond);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,218 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/via.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/items/bi_netline.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/board/items/bi_via.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/types/layer.h>
+
+#include <QtCore>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Helper Functions
+ ******************************************************************************/
+
+static std::unique_ptr<Project> openProject(
+    const std::shared_ptr<TransactionalFileSystem>& fs,
+    const QString& filename) {
+  ProjectLoader loader;
+  return loader.open(std::unique_ptr<TransactionalDirectory>(
+                         new TransactionalDirectory(fs)),
+                     filename);  // can throw
+}
+
+/*******************************************************************************
+ *  Benchmark Classes
+ ******************************************************************************/
+
+/**
+ * @brief Measures opening and saving of all projects in the test data
+ *        directory
+ *
+ * Projects with an outdated file format are upgraded while opening, just like
+ * in the application. Saving writes to the transactional file system only,
+ * i.e. to memory, so the disk I/O is not measured.
+ */
+class ProjectBenchmark : public ::benchmark::Fixture {
+public:
+  void SetUp(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    const FilePath dir(TEST_DATA_DIR "/projects");
+    foreach (const FilePath& fp,
+             FileUtils::getFilesInDirectory(dir, {"*.lpp"}, true)) {
+      std::shared_ptr<TransactionalFileSystem> fs =
+          TransactionalFileSystem::openRO(fp.getParentDir());
+      mFiles.append(fp);
+      mProjects.push_back(openProject(fs, fp.getFilename()));  // can throw
+    }
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    mFiles.clear();
+    mProjects.clear();
+  }
+
+protected:
+  QList<FilePath> mFiles;
+  std::vector<std::unique_ptr<Project>> mProjects;
+};
+
+/**
+ * @brief Measures opening and saving of a synthetic, scaled-up board
+ *
+ * Adds the given number of vias, connected by traces in chains of 10 vias
+ * per net segment, to the board of a test project. The scaled-up project is
+ * saved to the (in-memory) transactional file system once, so opening it
+ * again parses and loads the big board.
+ */
+class ScaledBoardBenchmark : public ::benchmark::Fixture {
+public:
+  void SetUp(const ::benchmark::State& state) override {
+    const FilePath projectFp(TEST_DATA_DIR
+                             "/projects/Nested Planes/project.lpp");
+    mFileSystem = TransactionalFileSystem::openRO(projectFp.getParentDir());
+    mFilename = projectFp.getFilename();
+    mProject = openProject(mFileSystem, mFilename);  // can throw
+    Board* board = mProject->getBoards().first();
+
+    // Add vias in a grid within the board area.
+    const int count = state.range(0);
+    const int columns = std::ceil(std::sqrt(count));
+    const auto rect = board->calculateBoundingRect();
+    const Point origin = rect ? rect->first : Point(0, 0);
+    const Point size = rect ? (rect->second - rect->first)
+                            : Point(100000000, 100000000);
+    BI_NetSegment* segment = nullptr;
+    QList<BI_Via*> vias;
+    QList<BI_NetLine*> netLines;
+    for (int i = 0; i < count; ++i) {
+      if (!segment) {
+        segment = new BI_NetSegment(*board, Uuid::createRandom(), nullptr);
+        board->addNetSegment(*segment);  // can throw
+      }
+      const Point pos = origin +
+          Point(size.getX() * ((i % columns) + 1) / (columns + 1),
+                size.getY() * ((i / columns) + 1) / (columns + 1));
+      BI_Via* via = new BI_Via(
+          *segment,
+          Via(Uuid::createRandom(), Layer::topCopper(), Layer::botCopper(), pos,
+              PositiveLength(500000), PositiveLength(300000),
+              MaskConfig::off()));
+      if (!vias.isEmpty()) {
+        netLines.append(new BI_NetLine(*segment, Uuid::createRandom(),
+                                       *vias.last(), *via, Layer::topCopper(),
+                                       PositiveLength(200000)));
+      }
+      vias.append(via);
+      if ((vias.count() == 10) || (i == count - 1)) {
+        segment->addElements(vias, {}, netLines);  // can throw
+        segment = nullptr;
+        vias.clear();
+        netLines.clear();
+      }
+    }
+    mProject->save();  // can throw
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    mProject.reset();
+    mFileSystem.reset();
+  }
+
+protected:
+  std::shared_ptr<TransactionalFileSystem> mFileSystem;
+  QString mFilename;
+  std::unique_ptr<Project> mProject;
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+BENCHMARK_F(ProjectBenchmark, Open)(::benchmark::State& state) {
+  for (auto _ : state) {
+    foreach (const FilePath& fp, mFiles) {
+      std::shared_ptr<TransactionalFileSystem> fs =
+          TransactionalFileSystem::openRO(fp.getParentDir());
+      ::benchmark::DoNotOptimize(openProject(fs, fp.getFilename()));
+    }
+  }
+  state.counters["projects"] = ::benchmark::Counter(
+      mFiles.count(), ::benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_F(ProjectBenchmark, Save)(::benchmark::State& state) {
+  for (auto _ : state) {
+    for (const auto& project : mProjects) {
+      project->save();  // can throw
+    }
+  }
+  state.counters["projects"] = ::benchmark::Counter(
+      mProjects.size(), ::benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_DEFINE_F(ScaledBoardBenchmark, Open)(::benchmark::State& state) {
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(openProject(mFileSystem, mFilename));
+  }
+}
+
+BENCHMARK_DEFINE_F(ScaledBoardBenchmark, Save)(::benchmark::State& state) {
+  for (auto _ : state) {
+    mProject->save();  // can throw
+  }
+}
+
+BENCHMARK_REGISTER_F(ScaledBoardBenchmark, Open)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(50000)
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(ScaledBoardBenchmark, Save)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(50000)
+    ->Unit(::benchmark::kMillisecond);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
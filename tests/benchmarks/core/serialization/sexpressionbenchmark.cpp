@@ -0,0 +1,103 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+/**
+ * @brief Measures the S-Expression parser and serializer throughput
+ *
+ * All S-Expression files of the projects in the test data directory are used
+ * as input. The byte-identical output of the serializer is verified by the
+ * unit tests (see SExpressionTest).
+ */
+class SExpressionBenchmark : public ::benchmark::Fixture {
+public:
+  void SetUp(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    const FilePath dir(TEST_DATA_DIR "/projects");
+    foreach (const FilePath& fp, FileUtils::getFilesInDirectory(
+                                     dir, {"*.lp", "*.lpp"}, true)) {
+      const QByteArray content = FileUtils::readFile(fp);  // can throw
+      mFiles.append(std::make_pair(fp, content));
+      mNodes.append(SExpression::parse(content, fp));  // can throw
+      mParsedBytes += content.size();
+      mSerializedBytes += mNodes.last().toByteArray().size();  // can throw
+    }
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    mFiles.clear();
+    mNodes.clear();
+    mParsedBytes = 0;
+    mSerializedBytes = 0;
+  }
+
+protected:
+  QVector<std::pair<FilePath, QByteArray>> mFiles;
+  QVector<SExpression> mNodes;
+  qint64 mParsedBytes = 0;
+  qint64 mSerializedBytes = 0;
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+BENCHMARK_F(SExpressionBenchmark, Parse)(::benchmark::State& state) {
+  for (auto _ : state) {
+    for (const auto& file : mFiles) {
+      ::benchmark::DoNotOptimize(SExpression::parse(file.second, file.first));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * mParsedBytes);
+}
+
+BENCHMARK_F(SExpressionBenchmark, Serialize)(::benchmark::State& state) {
+  for (auto _ : state) {
+    for (const SExpression& node : mNodes) {
+      ::benchmark::DoNotOptimize(node.toByteArray());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * mSerializedBytes);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
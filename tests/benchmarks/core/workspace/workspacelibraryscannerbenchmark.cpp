@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+/**
+ * @brief Measures the workspace library scan
+ *
+ * All libraries of the test data directory are copied into the libraries
+ * directory of a temporary workspace and scanned once, so legacy libraries
+ * are already upgraded before the measurement starts. A full scan starts with
+ * an empty library database, while a rescan only has to compare the
+ * fingerprints of the (unmodified) library elements.
+ */
+class WorkspaceLibraryScannerBenchmark : public ::benchmark::Fixture {
+public:
+  void SetUp(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    mLibrariesDir = FilePath::getRandomTempPath();
+    const FilePath src(TEST_DATA_DIR "/libraries");
+    foreach (const FilePath& fp, FileUtils::findDirectories(src)) {
+      if (fp.getSuffix() == "lplib") {
+        FileUtils::copyDirRecursively(
+            fp,
+            mLibrariesDir.getPathTo("local/" % fp.getFilename()));  // can throw
+      }
+    }
+    mDb.reset(new WorkspaceLibraryDb(mLibrariesDir));  // can throw
+    scan();
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    Q_UNUSED(state);
+    mDb.reset();
+    QDir(mLibrariesDir.toStr()).removeRecursively();
+  }
+
+protected:
+  void scan() noexcept {
+    QEventLoop loop;
+    QObject::connect(mDb.get(), &WorkspaceLibraryDb::scanFinished, &loop,
+                     &QEventLoop::quit);
+    mDb->startLibraryRescan();
+    loop.exec();
+  }
+
+  FilePath mLibrariesDir;
+  std::unique_ptr<WorkspaceLibraryDb> mDb;
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+BENCHMARK_F(WorkspaceLibraryScannerBenchmark, FullScan)
+(::benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    const FilePath dbFp = mDb->getFilePath();
+    mDb.reset();
+    QFile::remove(dbFp.toStr());
+    mDb.reset(new WorkspaceLibraryDb(mLibrariesDir));  // can throw
+    state.ResumeTiming();
+    scan();
+  }
+}
+
+BENCHMARK_F(WorkspaceLibraryScannerBenchmark, Rescan)
+(::benchmark::State& state) {
+  for (auto _ : state) {
+    scan();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
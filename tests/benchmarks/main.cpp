@@ -0,0 +1,73 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <librepcb/core/application.h>
+#include <librepcb/core/debug.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+using namespace librepcb;
+
+/*******************************************************************************
+ *  The Benchmark Program
+ ******************************************************************************/
+
+int main(int argc, char* argv[]) {
+  // initialize a common locale for all benchmarks
+  QLocale::setDefault(QLocale(QLocale::English, QLocale::UnitedStates));
+
+  // many classes rely on a QApplication instance, so we create it here
+  QApplication app(argc, argv);
+  QApplication::setOrganizationName("LibrePCB");
+  QApplication::setOrganizationDomain("librepcb.org");
+  QApplication::setApplicationName("LibrePCB-Benchmarks");
+
+  // disable the whole debug output (we want only the benchmark results)
+  Debug::instance()->setDebugLevelLogFile(Debug::DebugLevel_t::Nothing);
+  Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::Nothing);
+
+  // Perform global initialization tasks.
+  Application::loadBundledFonts();
+
+  // Add the application version to the results (e.g. the JSON output of
+  // "--benchmark_out=results.json"), to allow comparing them between
+  // releases.
+  ::benchmark::AddCustomContext("librepcb_version",
+                                Application::getVersion().toStdString());
+  ::benchmark::AddCustomContext("librepcb_git_revision",
+                                Application::getGitRevision().toStdString());
+
+  // init benchmark library and run all benchmarks
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/algorithm/spatialindex.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SpatialIndexTest : public ::testing::Test {
+protected:
+  static ClipperLib::IntRect rect(ClipperLib::cInt x, ClipperLib::cInt y,
+                                  ClipperLib::cInt w,
+                                  ClipperLib::cInt h) noexcept {
+    return ClipperLib::IntRect{x, y, x + w, y + h};
+  }
+
+  static QVector<int> bruteForce(const QVector<ClipperLib::IntRect>& items,
+                                 const ClipperLib::IntRect& r) noexcept {
+    QVector<int> result;
+    for (int i = 0; i < items.count(); ++i) {
+      if (SpatialIndex::intersects(items.at(i), r)) {
+        result.append(i);
+      }
+    }
+    return result;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SpatialIndexTest, testEmpty) {
+  SpatialIndex index;
+  EXPECT_EQ(0, index.getCount());
+  EXPECT_EQ(QVector<int>{}, index.query(rect(0, 0, 100, 100)));
+}
+
+TEST_F(SpatialIndexTest, testEmptyItemsAreNeverReturned) {
+  SpatialIndex index({SpatialIndex::emptyRect(), rect(0, 0, 10, 10)});
+  EXPECT_EQ(2, index.getCount());
+  EXPECT_EQ(QVector<int>{1}, index.query(rect(-100, -100, 200, 200)));
+  EXPECT_EQ(QVector<int>{}, index.query(SpatialIndex::emptyRect()));
+}
+
+TEST_F(SpatialIndexTest, testTouchingBoxesOverlap) {
+  SpatialIndex index({rect(0, 0, 10, 10), rect(10, 10, 10, 10)});
+  EXPECT_EQ(QVector<int>({0, 1}), index.queryNeighbours(0));
+  EXPECT_EQ(QVector<int>{1}, index.queryNeighbours(0, 1));
+  EXPECT_EQ(QVector<int>{}, index.queryNeighbours(1, 2));
+}
+
+TEST_F(SpatialIndexTest, testQueryOutsideExtents) {
+  SpatialIndex index({rect(0, 0, 10, 10), rect(50, 50, 10, 10)});
+  EXPECT_EQ(QVector<int>{}, index.query(rect(-100, -100, 50, 50)));
+  EXPECT_EQ(QVector<int>{}, index.query(rect(1000, 1000, 50, 50)));
+}
+
+TEST_F(SpatialIndexTest, testLargeItemsAreFound) {
+  QVector<ClipperLib::IntRect> items;
+  items.append(rect(-1000000, -1000000, 2000000, 2000000));  // Large item.
+  for (int i = 0; i < 100; ++i) {
+    items.append(rect(i * 1000, 0, 10, 10));
+  }
+  SpatialIndex index(items);
+  EXPECT_EQ(QVector<int>({0, 1}), index.query(rect(0, 0, 1, 1)));
+  EXPECT_EQ(QVector<int>({0}), index.query(rect(500, 500, 1, 1)));
+}
+
+TEST_F(SpatialIndexTest, testMatchesBruteForce) {
+  // Generate a reproducible set of boxes with very different sizes.
+  QVector<ClipperLib::IntRect> items;
+  quint32 seed = 42;
+  auto random = [&seed](int max) {
+    seed = seed * 1103515245u + 12345u;
+    return static_cast<ClipperLib::cInt>((seed >> 8) % max);
+  };
+  for (int i = 0; i < 500; ++i) {
+    const ClipperLib::cInt size =
+        (i % 50 == 0) ? random(500000) : random(5000);
+    items.append(rect(random(1000000) - 500000, random(1000000) - 500000,
+                      size, random(5000)));
+  }
+  SpatialIndex index(items);
+  for (int i = 0; i < items.count(); ++i) {
+    EXPECT_EQ(bruteForce(items, items.at(i)), index.queryNeighbours(i));
+  }
+  for (int i = 0; i < 50; ++i) {
+    const ClipperLib::IntRect r =
+        rect(random(2000000) - 1000000, random(2000000) - 1000000,
+             random(100000), random(100000));
+    EXPECT_EQ(bruteForce(items, r), index.query(r));
+  }
+}
+
+TEST_F(SpatialIndexTest, testGetBounds) {
+  const ClipperLib::Paths paths = {
+      {{10, 20}, {30, -40}},
+      {{-5, 0}, {0, 100}},
+  };
+  const ClipperLib::IntRect bounds = SpatialIndex::getBounds(paths);
+  EXPECT_EQ(-5, bounds.left);
+  EXPECT_EQ(-40, bounds.top);
+  EXPECT_EQ(30, bounds.right);
+  EXPECT_EQ(100, bounds.bottom);
+  EXPECT_TRUE(
+      SpatialIndex::isEmpty(SpatialIndex::getBounds(ClipperLib::Paths())));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -24,6 +24,7 @@
 #include <gtest/gtest.h>
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/serialization/sexpression.h>
 #include <librepcb/core/utils/toolbox.h>
 #include <quazip/quazip.h>
 
@@ -441,6 +442,34 @@ TEST_F(TransactionalFileSystemTest, testAutosaveIsRemovedInDestructor) {
   EXPECT_FALSE(fp.isExistingDir());
 }
 
+TEST_F(TransactionalFileSystemTest, testStartAutosave) {
+  FilePath fp = mPopulatedDir.getPathTo(".autosave/autosave.lp");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("1.txt", "new 1");
+  QFuture<bool> future = fs.startAutosave();
+  fs.write("1.txt", "new 2");  // must not affect the running autosave
+  future.waitForFinished();
+  EXPECT_TRUE(future.result());
+  ASSERT_TRUE(fp.isExistingFile());
+
+  // restore the autosave to check its content
+  FileUtils::removeFile(mPopulatedDir.getPathTo(".lock"));
+  TransactionalFileSystem fs2(mPopulatedDir, true,
+                              &TransactionalFileSystem::RestoreMode::yes);
+  EXPECT_TRUE(fs2.isRestoredFromAutosave());
+  EXPECT_EQ("new 1", fs2.read("1.txt"));
+}
+
+TEST_F(TransactionalFileSystemTest, testStartedAutosaveIsRemovedWhenSaving) {
+  FilePath fp = mPopulatedDir.getPathTo(".autosave");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("1.txt", "new 1");
+  fs.startAutosave();
+  fs.save();
+  EXPECT_FALSE(fp.isExistingDir());
+  EXPECT_EQ("new 1", FileUtils::readFile(fs.getAbsPath("1.txt")));
+}
+
 TEST_F(TransactionalFileSystemTest, testRestoreAutosave) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -750,6 +779,58 @@ TEST_F(TransactionalFileSystemTest, testCheckForModifications) {
   EXPECT_EQ(0, fs.checkForModifications().count());
 }
 
+TEST_F(TransactionalFileSystemTest, testWriteUnchangedContent) {
+  const FilePath fp = mPopulatedDir.getPathTo(".autosave/autosave.lp");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  auto getAutosavedFiles = [&]() {
+    fs.autosave();
+    QStringList files;
+    const SExpression root =
+        SExpression::parse(FileUtils::readFile(fp), fp);  // can throw
+    foreach (const SExpression* child, root.getChildren("modified_file")) {
+      files.append(child->getChild("@0").getValue());
+    }
+    return files;
+  };
+
+  // writing the content read from disk must not lead to a modification
+  fs.write("1.txt", fs.read("1.txt"));
+  EXPECT_EQ(QStringList(), getAutosavedFiles());
+
+  // modified content must be written, and reverting it must work too
+  fs.write("1.txt", "new 1");
+  EXPECT_EQ(QStringList{"1.txt"}, getAutosavedFiles());
+  fs.write("1.txt", "1");
+  EXPECT_EQ(QStringList(), getAutosavedFiles());
+
+  // writing an unchanged file after removing it must restore it
+  fs.removeFile("1.txt");
+  fs.write("1.txt", "1");
+  EXPECT_EQ("1", fs.read("1.txt"));
+  EXPECT_EQ(QStringList(), getAutosavedFiles());
+
+  // but within a removed directory, it must be written again
+  fs.write("a/b/c", fs.read("a/b/c"));
+  fs.removeDirRecursively("a");
+  fs.write("a/b/c", "c");
+  EXPECT_EQ(QStringList{"a/b/c"}, getAutosavedFiles());
+  fs.save();
+  EXPECT_EQ("c", FileUtils::readFile(mPopulatedDir.getPathTo("a/b/c")));
+
+  // saved content must be known as unchanged afterwards
+  fs.write("2.txt", "new 2");
+  fs.save();
+  fs.write("2.txt", "new 2");
+  EXPECT_EQ(QStringList(), getAutosavedFiles());
+
+  // removing a directory must not affect files with the same name prefix
+  fs.read("foo dir/bar dir.txt");
+  fs.removeDirRecursively("foo dir/bar dir");
+  fs.save();
+  fs.write("foo dir/bar dir.txt", "bar");
+  EXPECT_EQ(QStringList(), getAutosavedFiles());
+}
+
 TEST_F(TransactionalFileSystemTest, testReleaseLock) {
   const FilePath lockFp = mPopulatedDir.getPathTo(".lock");
 
@@ -25,6 +25,7 @@
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/dev/device.h>
+#include <librepcb/core/library/dev/part.h>
 
 #include <QtCore>
 
@@ -86,6 +87,45 @@ TEST_F(DeviceTest, testUpgradeV01) {
   { std::unique_ptr<Device> obj = Device::open(createDir()); }
 }
 
+TEST_F(DeviceTest, testLoadMetadata) {
+  // Copy into temporary directory.
+  const FilePath src =
+      FilePath(TEST_DATA_DIR "/libraries/v0.1.lplib/dev").getPathTo(sUuid);
+  FileUtils::copyDirRecursively(src, mTmpDir);
+
+  // Metadata can't be loaded before upgrading the file format.
+  EXPECT_FALSE(LibraryBaseElement::loadMetadata<Device>(*createDir(false)));
+
+  // Upgrade and add a part, since the test data doesn't contain any parts.
+  {
+    std::unique_ptr<Device> obj = Device::open(createDir());
+    obj->getParts().append(std::make_shared<Part>(
+        SimpleString("mpn 1"), SimpleString("man 1"), AttributeList{}));
+    obj->save();
+    obj->getDirectory().getFileSystem()->save();
+  }
+
+  // Load metadata and compare it with the fully loaded device.
+  std::unique_ptr<Device> obj = Device::open(createDir(false));
+  std::unique_ptr<Device::Metadata> metadata =
+      LibraryBaseElement::loadMetadata<Device>(*createDir(false));
+  ASSERT_TRUE(metadata != nullptr);
+  EXPECT_EQ(std::string(sUuid), metadata->uuid.toStr().toStdString());
+  EXPECT_EQ(obj->getUuid(), metadata->uuid);
+  EXPECT_EQ(obj->getVersion(), metadata->version);
+  EXPECT_EQ(obj->isDeprecated(), metadata->deprecated);
+  EXPECT_EQ(obj->getNames(), metadata->names);
+  EXPECT_EQ(obj->getDescriptions(), metadata->descriptions);
+  EXPECT_EQ(obj->getKeywords(), metadata->keywords);
+  EXPECT_EQ(obj->getCategories(), metadata->categories);
+  EXPECT_EQ(obj->getComponentUuid(), metadata->componentUuid);
+  EXPECT_EQ(obj->getPackageUuid(), metadata->packageUuid);
+  EXPECT_EQ(obj->getParts(), metadata->parts);
+  ASSERT_EQ(1, metadata->parts.count());
+  EXPECT_EQ("mpn 1", *metadata->parts.first()->getMpn());
+  EXPECT_EQ("man 1", *metadata->parts.first()->getManufacturer());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
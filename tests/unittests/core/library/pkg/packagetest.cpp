@@ -25,6 +25,7 @@
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/serialization/sexpression.h>
 
 #include <QtCore>
 
@@ -86,6 +87,60 @@ TEST_F(PackageTest, testUpgradeV01) {
   { std::unique_ptr<Package> obj = Package::open(createDir()); }
 }
 
+TEST_F(PackageTest, testLoadMetadata) {
+  // Copy into temporary directory.
+  const FilePath src =
+      FilePath(TEST_DATA_DIR "/libraries/v0.1.lplib/pkg").getPathTo(sUuid);
+  FileUtils::copyDirRecursively(src, mTmpDir);
+
+  // Metadata can't be loaded before upgrading the file format.
+  EXPECT_FALSE(LibraryBaseElement::loadMetadata<Package>(*createDir(false)));
+
+  // Upgrade.
+  {
+    std::unique_ptr<Package> obj = Package::open(createDir());
+    obj->save();
+    obj->getDirectory().getFileSystem()->save();
+  }
+
+  // Add alternative names, since the test data doesn't contain any and there
+  // is no setter for them.
+  const QList<Package::AlternativeName> alternativeNames = {
+      Package::AlternativeName(ElementName("alt 1"), SimpleString("ref 1")),
+      Package::AlternativeName(ElementName("alt 2"), SimpleString("")),
+  };
+  const FilePath fp = mTmpDir.getPathTo("package.lp");
+  SExpression root = SExpression::parse(FileUtils::readFile(fp), fp);
+  foreach (const Package::AlternativeName& name, alternativeNames) {
+    name.serialize(root.appendList("alternative_name"));
+  }
+  FileUtils::writeFile(fp, root.toByteArray());
+
+  // Load metadata and compare it with the fully loaded package.
+  std::unique_ptr<Package> obj = Package::open(createDir(false));
+  std::unique_ptr<Package::Metadata> metadata =
+      LibraryBaseElement::loadMetadata<Package>(*createDir(false));
+  ASSERT_TRUE(metadata != nullptr);
+  EXPECT_EQ(std::string(sUuid), metadata->uuid.toStr().toStdString());
+  EXPECT_EQ(obj->getUuid(), metadata->uuid);
+  EXPECT_EQ(obj->getVersion(), metadata->version);
+  EXPECT_EQ(obj->isDeprecated(), metadata->deprecated);
+  EXPECT_EQ(obj->getNames(), metadata->names);
+  EXPECT_EQ(obj->getDescriptions(), metadata->descriptions);
+  EXPECT_EQ(obj->getKeywords(), metadata->keywords);
+  EXPECT_EQ(obj->getCategories(), metadata->categories);
+  ASSERT_EQ(alternativeNames.count(), obj->getAlternativeNames().count());
+  ASSERT_EQ(alternativeNames.count(), metadata->alternativeNames.count());
+  for (int i = 0; i < alternativeNames.count(); ++i) {
+    EXPECT_EQ(alternativeNames.at(i).name, obj->getAlternativeNames()[i].name);
+    EXPECT_EQ(alternativeNames.at(i).name, metadata->alternativeNames[i].name);
+    EXPECT_EQ(alternativeNames.at(i).reference,
+              obj->getAlternativeNames()[i].reference);
+    EXPECT_EQ(alternativeNames.at(i).reference,
+              metadata->alternativeNames[i].reference);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
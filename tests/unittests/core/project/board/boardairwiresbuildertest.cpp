@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/via.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardairwiresbuilder.h>
+#include <librepcb/core/project/board/items/bi_airwire.h>
+#include <librepcb/core/project/board/items/bi_device.h>
+#include <librepcb/core/project/board/items/bi_footprintpad.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/board/items/bi_via.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/netsignal.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/serialization/sexpression.h>
+#include <librepcb/core/types/layer.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+/**
+ * @brief Checks that incremental airwire updates of a ::librepcb::Board
+ *        lead to the same airwires as building them from scratch
+ */
+class BoardAirWiresBuilderTest : public ::testing::Test {
+protected:
+  static QString toString(const BI_NetLineAnchor& p1,
+                          const BI_NetLineAnchor& p2) {
+    QStringList anchors = {toString(p1), toString(p2)};
+    anchors.sort();
+    return anchors.join(" <-> ");
+  }
+
+  static QString toString(const BI_NetLineAnchor& anchor) {
+    SExpression node = SExpression::createList("anchor");
+    anchor.toTraceAnchor().serialize(node);
+    return QString::fromUtf8(node.toByteArray()).trimmed() % " @ " %
+        anchor.getPosition().getX().toNmString() % "/" %
+        anchor.getPosition().getY().toNmString();
+  }
+
+  static QStringList getAirWires(const Board& board) {
+    QStringList airWires;
+    foreach (const BI_AirWire* airWire, board.getAirWires()) {
+      airWires.append(toString(airWire->getP1(), airWire->getP2()));
+    }
+    airWires.sort();
+    return airWires;
+  }
+
+  static QStringList buildAirWiresFromScratch(const Board& board) {
+    QStringList airWires;
+    foreach (const NetSignal* netSignal,
+             board.getProject().getCircuit().getNetSignals()) {
+      BoardAirWiresBuilder builder(board, *netSignal);
+      foreach (const auto& airWire, builder.buildAirWires()) {
+        airWires.append(toString(*airWire.first, *airWire.second));
+      }
+    }
+    airWires.sort();
+    return airWires;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardAirWiresBuilderTest, testIncrementalUpdates) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+  Board* board = project->getBoards().first();
+  board->forceAirWiresRebuild();
+  ASSERT_FALSE(getAirWires(*board).isEmpty());
+  EXPECT_EQ(buildAirWiresFromScratch(*board), getAirWires(*board));
+
+  // move a device
+  BI_Device* device = nullptr;
+  NetSignal* netSignal = nullptr;
+  foreach (BI_Device* dev, board->getDeviceInstances()) {
+    foreach (const BI_FootprintPad* pad, dev->getPads()) {
+      if (pad->getCompSigInstNetSignal()) {
+        device = dev;
+        netSignal = pad->getCompSigInstNetSignal();
+      }
+    }
+  }
+  ASSERT_TRUE(device);
+  ASSERT_TRUE(netSignal);
+  device->setPosition(device->getPosition() + Point(5000000, 3000000));
+  board->triggerAirWiresRebuild();
+  EXPECT_EQ(buildAirWiresFromScratch(*board), getAirWires(*board));
+
+  // move the device again, like while dragging it
+  device->setPosition(device->getPosition() + Point(-9000000, 1000000));
+  board->triggerAirWiresRebuild();
+  EXPECT_EQ(buildAirWiresFromScratch(*board), getAirWires(*board));
+
+  // add vias to the net of the moved device
+  BI_NetSegment* segment =
+      new BI_NetSegment(*board, Uuid::createRandom(), netSignal);
+  board->addNetSegment(*segment);  // can throw
+  QList<BI_Via*> vias;
+  for (int i = 0; i < 3; ++i) {
+    vias.append(new BI_Via(
+        *segment,
+        Via(Uuid::createRandom(), Layer::topCopper(), Layer::botCopper(),
+            device->getPosition() + Point(i * 2000000, -4000000),
+            PositiveLength(500000), PositiveLength(300000),
+            MaskConfig::off())));
+  }
+  segment->addElements(vias, {}, {});  // can throw
+  board->triggerAirWiresRebuild();
+  EXPECT_EQ(buildAirWiresFromScratch(*board), getAirWires(*board));
+
+  // move a via
+  vias.first()->setPosition(vias.first()->getPosition() + Point(0, 7000000));
+  board->triggerAirWiresRebuild();
+  EXPECT_EQ(buildAirWiresFromScratch(*board), getAirWires(*board));
+
+  // remove the vias again
+  board->removeNetSegment(*segment);  // can throw
+  board->triggerAirWiresRebuild();
+  EXPECT_EQ(buildAirWiresFromScratch(*board), getAirWires(*board));
+  delete segment;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -24,12 +24,16 @@
 #include <librepcb/core/application.h>
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/via.h>
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/board/boardplanefragmentsbuilder.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
 #include <librepcb/core/project/board/items/bi_plane.h>
+#include <librepcb/core/project/board/items/bi_via.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/project/projectloader.h>
 #include <librepcb/core/serialization/sexpression.h>
+#include <librepcb/core/types/layer.h>
 
 #include <QtCore>
 
@@ -49,7 +53,8 @@ namespace tests {
  *
  * In the test data directory is a project containing some planes and a file
  * with the expected paths of all plane fragments. This test then re-calculates
- * all plane fragments and compares them with the expected fragments.
+ * all plane fragments and compares them with the expected fragments. In
+ * addition, incremental rebuilds are compared with full rebuilds.
  */
 class BoardPlaneFragmentsBuilderTest : public ::testing::Test {};
 
@@ -106,6 +111,75 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expected.toStdString(), actual.toStdString());
 }
 
+TEST(BoardPlaneFragmentsBuilderTest, testIncrementalRebuild) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+  Board* board = project->getBoards().first();
+  auto getFragments = [board]() {
+    QMap<Uuid, QVector<Path>> fragments;
+    foreach (const BI_Plane* plane, board->getPlanes()) {
+      fragments[plane->getUuid()] = plane->getFragments();
+    }
+    return fragments;
+  };
+
+  // initial build, then rebuild without any modifications
+  BoardPlaneFragmentsBuilder builder;
+  builder.runSynchronously(*board);  // can throw
+  const QMap<Uuid, QVector<Path>> initialFragments = getFragments();
+  builder.runSynchronously(*board);  // can throw
+  EXPECT_EQ(initialFragments, getFragments());
+
+  // modify a plane and rebuild incrementally
+  BI_Plane* plane = board->getPlanes().first();
+  plane->setMinClearance(
+      UnsignedLength(*plane->getMinClearance() + Length(500000)));
+  builder.runSynchronously(*board);  // can throw
+  const QMap<Uuid, QVector<Path>> incrementalFragments = getFragments();
+
+  // compare with a full rebuild
+  BoardPlaneFragmentsBuilder fullBuilder;
+  fullBuilder.runSynchronously(*board);  // can throw
+  EXPECT_EQ(incrementalFragments, getFragments());
+
+  // add a via close to the outline of one plane, but far away from the other
+  // planes, then move it to another plane and remove it again
+  const QList<BI_Plane*> planes = board->getPlanes().values();
+  ASSERT_GE(planes.count(), 2);
+  const Point pos1 =
+      planes.first()->getOutline().getVertices().first().getPos();
+  const Point pos2 =
+      planes.last()->getOutline().getVertices().first().getPos();
+  ASSERT_NE(pos1, pos2);
+  BI_NetSegment* segment =
+      new BI_NetSegment(*board, Uuid::createRandom(), nullptr);
+  board->addNetSegment(*segment);  // can throw
+  BI_Via* via = new BI_Via(
+      *segment,
+      Via(Uuid::createRandom(), Layer::topCopper(), Layer::botCopper(), pos1,
+          PositiveLength(800000), PositiveLength(400000), MaskConfig::off()));
+  segment->addElements({via}, {}, {});  // can throw
+  auto checkIncrementalRebuild = [&]() {
+    builder.runSynchronously(*board);  // can throw
+    const QMap<Uuid, QVector<Path>> incremental = getFragments();
+    BoardPlaneFragmentsBuilder().runSynchronously(*board);  // can throw
+    EXPECT_EQ(incremental, getFragments());
+  };
+  checkIncrementalRebuild();
+  via->setPosition(pos2);
+  checkIncrementalRebuild();
+  board->removeNetSegment(*segment);  // can throw
+  checkIncrementalRebuild();
+  delete segment;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
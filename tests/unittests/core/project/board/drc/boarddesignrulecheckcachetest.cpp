@@ -0,0 +1,129 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/project/board/drc/boarddesignrulecheckcache.h>
+#include <librepcb/core/types/layer.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardDesignRuleCheckCacheTest : public ::testing::Test {
+protected:
+  BoardDesignRuleCheckCache::ItemId getArea(BoardDesignRuleCheckCache& cache,
+                                            const void* item,
+                                            const ClipperLib::Paths& copper,
+                                            ClipperLib::Paths& clearance) {
+    return cache.getClearanceArea(
+        item, nullptr, &Layer::topCopper(), Length(100), copper, clearance,
+        [this, &copper](ClipperLib::Paths& area) {
+          ++mCalculations;
+          area = copper;
+          area.push_back({{0, 0}, {1, 1}, {0, 1}});
+        });
+  }
+
+  int mCalculations = 0;
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardDesignRuleCheckCacheTest, testUnmodifiedItemIsCached) {
+  BoardDesignRuleCheckCache cache;
+  const int item = 0;
+  const ClipperLib::Paths copper = {{{0, 0}, {10, 0}, {10, 10}}};
+  ClipperLib::Paths clearance1, clearance2;
+
+  cache.beginRun();
+  const auto id1 = getArea(cache, &item, copper, clearance1);
+  cache.endRun();
+  cache.beginRun();
+  const auto id2 = getArea(cache, &item, copper, clearance2);
+  cache.endRun();
+
+  EXPECT_EQ(1, mCalculations);
+  EXPECT_EQ(id1, id2);
+  EXPECT_EQ(clearance1, clearance2);
+  EXPECT_EQ(2U, clearance2.size());
+}
+
+TEST_F(BoardDesignRuleCheckCacheTest, testModifiedItemIsRecalculated) {
+  BoardDesignRuleCheckCache cache;
+  const int item = 0;
+  ClipperLib::Paths clearance;
+
+  cache.beginRun();
+  const auto id1 =
+      getArea(cache, &item, {{{0, 0}, {10, 0}, {10, 10}}}, clearance);
+  cache.endRun();
+  cache.beginRun();
+  const auto id2 =
+      getArea(cache, &item, {{{0, 0}, {20, 0}, {20, 20}}}, clearance);
+  cache.endRun();
+
+  EXPECT_EQ(2, mCalculations);
+  EXPECT_NE(id1, id2);
+}
+
+TEST_F(BoardDesignRuleCheckCacheTest, testPairResults) {
+  BoardDesignRuleCheckCache cache;
+  const QVector<Path> locations = {Path::circle(PositiveLength(1000))};
+  QVector<Path> result;
+
+  // Results are only available in the run after they were set.
+  cache.beginRun();
+  cache.setPairResult(1, 2, locations);
+  EXPECT_FALSE(cache.getPairResult(1, 2, result));
+  cache.endRun();
+
+  // Results are kept as long as they are accessed in each run.
+  cache.beginRun();
+  EXPECT_TRUE(cache.getPairResult(1, 2, result));
+  EXPECT_EQ(locations, result);
+  EXPECT_FALSE(cache.getPairResult(2, 1, result));
+  cache.setPairResult(1, 2, result);
+  cache.endRun();
+
+  // Results not used in a run are discarded.
+  cache.beginRun();
+  EXPECT_TRUE(cache.getPairResult(1, 2, result));
+  cache.endRun();
+  cache.beginRun();
+  EXPECT_FALSE(cache.getPairResult(1, 2, result));
+  cache.endRun();
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
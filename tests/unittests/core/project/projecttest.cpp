@@ -24,6 +24,7 @@
 #include <librepcb/core/application.h>
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/project/projectloader.h>
 
@@ -228,6 +229,81 @@ TEST_F(ProjectTest, testSettersGetters) {
   EXPECT_EQ(version, project->getVersion());
 }
 
+TEST_F(ProjectTest, testLoadBoardsOnDemand) {
+  // create new project with two boards
+  std::unique_ptr<Project> project =
+      Project::create(createDir(), mProjectFile.getFilename());
+  for (const QString& name : {"board 1", "board 2"}) {
+    Board* board = new Board(
+        *project,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        FilePath::cleanFileName(name, FilePath::ReplaceSpaces),
+        Uuid::createRandom(), ElementName(name));
+    board->addDefaultContent();
+    project->addBoard(*board);
+  }
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+
+  // re-open project, boards are loaded on demand
+  project.reset();
+  ProjectLoader loader;
+  loader.setLoadBoardsOnDemand(true);
+  project = loader.open(createDir(), mProjectFile.getFilename());
+  EXPECT_TRUE(project->hasPendingBoards());
+  EXPECT_EQ(0, project->getBoards().count());
+  EXPECT_FALSE(project->getPrimaryBoard());
+  project->loadBoards(1);
+  ASSERT_TRUE(project->getPrimaryBoard());
+  EXPECT_EQ("board 1", *project->getPrimaryBoard()->getName());
+  EXPECT_EQ(1, project->getBoards().count());
+  EXPECT_TRUE(project->hasPendingBoards());
+
+  // saving must not remove boards which are not loaded yet
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  EXPECT_TRUE(project->hasPendingBoards());
+  project->loadBoards();
+  EXPECT_EQ(2, project->getBoards().count());
+  EXPECT_FALSE(project->hasPendingBoards());
+
+  // re-open project, all boards are loaded immediately
+  project.reset();
+  project = ProjectLoader().open(createDir(), mProjectFile.getFilename());
+  EXPECT_FALSE(project->hasPendingBoards());
+  ASSERT_EQ(2, project->getBoards().count());
+  EXPECT_EQ("board 1", *project->getBoards().at(0)->getName());
+  EXPECT_EQ("board 2", *project->getBoards().at(1)->getName());
+}
+
+TEST_F(ProjectTest, testSaveSkipsUnmodifiedBoards) {
+  // create new project with a board
+  std::unique_ptr<Project> project =
+      Project::create(createDir(), mProjectFile.getFilename());
+  Board* board = new Board(
+      *project,
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+      "board", Uuid::createRandom(), ElementName("board"));
+  board->addDefaultContent();
+  project->addBoard(*board);
+  EXPECT_TRUE(board->isModified());
+  project->save();
+  EXPECT_FALSE(board->isModified());
+
+  // saving again must not serialize the unmodified board
+  TransactionalDirectory& dir = board->getDirectory();
+  dir.write("board.lp", "dummy");
+  project->save();
+  EXPECT_EQ("dummy", dir.read("board.lp"));
+
+  // after modifying the board, it is serialized again
+  board->setName(ElementName("new name"));
+  EXPECT_TRUE(board->isModified());
+  project->save();
+  EXPECT_FALSE(board->isModified());
+  EXPECT_TRUE(dir.read("board.lp").startsWith("(librepcb_board "));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include <gtest/gtest.h>
 #include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/serialization/sexpression.h>
 
 #include <QtCore>
@@ -32,6 +33,69 @@
 namespace librepcb {
 namespace tests {
 
+/*******************************************************************************
+ *  Helper Functions
+ ******************************************************************************/
+
+static QString toStringReference(const SExpression& node, int indent) {
+  if (node.isList()) {
+    QString str = '(' + node.getName();
+    bool lastCharIsSpace = false;
+    const QList<SExpression>& children = node.getChildren();
+    const int lastIndex = children.count() - 1;
+    for (int i = 0; i < children.count(); ++i) {
+      const SExpression& child = children.at(i);
+      if ((!lastCharIsSpace) && (!child.isLineBreak())) {
+        str += ' ';
+      }
+      const bool nextChildIsLineBreak =
+          (i < lastIndex) && children.at(i + 1).isLineBreak();
+      int currentIndent =
+          (child.isLineBreak() && nextChildIsLineBreak) ? 0 : (indent + 1);
+      lastCharIsSpace = child.isLineBreak() && (currentIndent > 0);
+      if (lastCharIsSpace && (i == lastIndex)) {
+        --currentIndent;
+      }
+      str += toStringReference(child, currentIndent);
+    }
+    return str + ')';
+  } else if (node.isToken()) {
+    return node.getValue();
+  } else if (node.isString()) {
+    const QHash<QChar, QString> replacements = {
+        {'"', "\\\""},
+        {'\\', "\\\\"},
+        {'\b', "\\b"},
+        {'\f', "\\f"},
+        {'\n', "\\n"},
+        {'\r', "\\r"},
+        {'\t', "\\t"},
+        {'\v', "\\v"},
+    };
+    QString str = "\"";
+    foreach (const QChar& c, node.getValue()) {
+      str += replacements.value(c, c);
+    }
+    return str + '"';
+  } else {
+    return '\n' + QString(' ').repeated(indent);
+  }
+}
+
+/**
+ * @brief Straightforward QString based serialization
+ *
+ * Used as reference to verify that the optimized serialization of
+ * ::librepcb::SExpression::toByteArray() produces exactly the same output.
+ */
+static QByteArray toByteArrayReference(const SExpression& node) {
+  QString str = toStringReference(node, 0);
+  if (!str.endsWith('\n')) {
+    str += '\n';
+  }
+  return str.toUtf8();
+}
+
 /*******************************************************************************
  *  Test Class
  ******************************************************************************/
@@ -100,6 +164,35 @@ TEST(SExpressionTest, testParseStringWithBackslash) {
   EXPECT_EQ("foo\\bar", s.getChild("@0").getValue());
 }
 
+TEST(SExpressionTest, testParseStringWithLegacyEscapeSequences) {
+  SExpression s =
+      SExpression::parse("(test \"\\'\\?\\a\\b\\f\\r\\t\\v\")", FilePath());
+  EXPECT_EQ("'?\a\b\f\r\t\v", s.getChild("@0").getValue());
+}
+
+TEST(SExpressionTest, testParseStringWithIllegalEscapeSequence) {
+  EXPECT_THROW(SExpression::parse("(test \"foo\\xbar\")", FilePath()),
+               RuntimeError);
+}
+
+TEST(SExpressionTest, testParseStringWithUnicode) {
+  SExpression s = SExpression::parse(
+      QString("(test \"\u00B5F \u2126 \\\"\U0001F600\\\"\")").toUtf8(),
+      FilePath());
+  EXPECT_EQ(QString("\u00B5F \u2126 \"\U0001F600\""),
+            s.getChild("@0").getValue());
+}
+
+TEST(SExpressionTest, testParseWithByteOrderMark) {
+  SExpression s = SExpression::parse("\xEF\xBB\xBF(test foo)", FilePath());
+  EXPECT_EQ("foo", s.getChild("@0").getValue());
+}
+
+TEST(SExpressionTest, testParseInvalidTokenCharacter) {
+  const QByteArray input = QString("(test \u00E4)").toUtf8();
+  EXPECT_THROW(SExpression::parse(input, FilePath()), RuntimeError);
+}
+
 TEST(SExpressionTest, testParseExpressionWithChildrenAndComments) {
   QByteArray input =
       "; (This whole line is a comment with CRLF line ending)\r\n"
@@ -208,6 +301,33 @@ TEST(SExpressionTest, testRoundtrip) {
   EXPECT_EQ(expected.toStdString(), actual.toStdString());
 }
 
+TEST(SExpressionTest, testToByteArrayMatchesReference) {
+  SExpression s = SExpression::createList("test");
+  s.appendChild(SExpression::createString(
+      QString("\u00B5F \u2126 \U0001F600 \"\\\b\f\n\r\t\v\a ;()")));
+  s.ensureLineBreak();
+  s.appendChild("child", SExpression::createToken("-1.5"));
+  s.ensureLineBreak();
+  s.ensureLineBreak();
+  s.appendList("empty").ensureLineBreak();
+  s.appendChild(SExpression::createString(""));
+  s.ensureLineBreak();
+  EXPECT_EQ(toByteArrayReference(s).toStdString(),
+            s.toByteArray().toStdString());
+}
+
+TEST(SExpressionTest, testToByteArrayOfTestDataMatchesReference) {
+  const FilePath dir(TEST_DATA_DIR "/projects");
+  const QList<FilePath> files =
+      FileUtils::getFilesInDirectory(dir, {"*.lp", "*.lpp"}, true);
+  foreach (const FilePath& fp, files) {
+    const SExpression s = SExpression::parse(FileUtils::readFile(fp), fp);
+    EXPECT_EQ(toByteArrayReference(s).toStdString(),
+              s.toByteArray().toStdString())
+        << qPrintable(fp.toStr());
+  }
+}
+
 TEST(SExpressionTest, testGetChildSkipsLineBreaks) {
   SExpression s =
       SExpression::parse("(root \n (child \n 0 \n 1 \n 2 \n ))", FilePath());
@@ -216,6 +336,31 @@ TEST(SExpressionTest, testGetChildSkipsLineBreaks) {
   EXPECT_EQ("2", s.getChild("child/@2").getValue().toStdString());
 }
 
+TEST(SExpressionTest, testGetChildOfWideList) {
+  // Lists with many children are indexed, make sure the lookup still returns
+  // the first match and takes modifications into account.
+  QByteArray input = "(root\n";
+  for (int i = 0; i < 100; ++i) {
+    input += " (child" + QByteArray::number(i % 50) + " " +
+        QByteArray::number(i) + ")\n";
+  }
+  input += ")\n";
+  SExpression s = SExpression::parse(input, FilePath());
+  const SExpression& cs = s;
+  EXPECT_EQ("7", cs.getChild("child7/@0").getValue().toStdString());
+  EXPECT_EQ("49", cs.getChild(QString("child49/@0")).getValue().toStdString());
+  EXPECT_EQ("child3", cs.getChild("@3").getName().toStdString());
+  EXPECT_EQ(nullptr, cs.tryGetChild("child50"));
+  EXPECT_EQ(nullptr, cs.tryGetChild("child7/@1"));
+  EXPECT_THROW(cs.getChild("foo"), FileParseError);
+
+  s.appendChild("child50", SExpression::createToken("100"));
+  EXPECT_EQ("100", cs.getChild("child50/@0").getValue().toStdString());
+  s.getChild("child0").setName("foo");
+  EXPECT_EQ("50", cs.getChild("child0/@0").getValue().toStdString());
+  EXPECT_EQ("0", cs.getChild("foo/@0").getValue().toStdString());
+}
+
 TEST(SExpressionTest, testRemoveChild) {
   const QByteArray input =
       "(test value\n"
@@ -145,6 +145,19 @@ TEST_P(UuidTest, testOperatorComparisons) {
   }
 }
 
+TEST_P(UuidTest, testQHash) {
+  const UuidTestData& data = GetParam();
+  if (data.valid) {
+    const Uuid uuid1 = Uuid::fromString(data.uuid);
+    const Uuid uuid2 = Uuid::fromString(data.uuid);
+    const Uuid uuid3 =
+        Uuid::fromString("d2c30518-5cd1-4ce9-a569-44f783a3f66a");  // valid UUID
+    EXPECT_EQ(qHash(uuid1, 42), qHash(uuid2, 42));
+    EXPECT_NE(qHash(uuid1, 42), qHash(uuid3, 42));
+    EXPECT_EQ(qHash(uuid1, 42), qHash(tl::make_optional(uuid2), 42));
+  }
+}
+
 TEST(UuidTest, testCreateRandom) {
   for (int i = 0; i < 1000; i++) {
     Uuid uuid = Uuid::createRandom();
@@ -405,6 +405,76 @@ TEST_F(WorkspaceLibraryDbTest, testFindWithMultipleTranslations) {
             str(mWsDb->find<Symbol>("sym1 en_US name")));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testFindRanking) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("a resistor"), "", "");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.1"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("resistor array"), "",
+                                  "");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym3"), uuid(3), version("0.1"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("Resistor"), "", "");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym4"), uuid(4), version("0.1"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("foo"), "", "resistor");
+
+  // Exact matches first, then prefix matches, then all others.
+  EXPECT_EQ(str(QList<Uuid>{uuid(3), uuid(2), uuid(1), uuid(4)}),
+            str(mWsDb->find<Symbol>("resistor")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(3), uuid(2), uuid(1), uuid(4)}),
+            str(mWsDb->find<Symbol>("res")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(3), uuid(2), uuid(1), uuid(4)}),
+            str(mWsDb->find<Symbol>("r")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindSpecialCharacters) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the \"sym1\" name"),
+                                  "", "foo AND (bar)*");
+
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}),
+            str(mWsDb->find<Symbol>("\"sym1\" name")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->find<Symbol>("AND (bar)*")));
+  EXPECT_EQ(str(QList<Uuid>{}), str(mWsDb->find<Symbol>("sym1 OR foo")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindPackageAlternativeNames) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int pkg = mWriter->addElement<Package>(lib, toAbs("pkg1"), uuid(1),
+                                         version("0.1"), false);
+  mWriter->addTranslation<Package>(pkg, "", ElementName("SOIC127P600X175-8"),
+                                   "", "");
+  mWriter->addAlternativeName(pkg, ElementName("SO-8"), SimpleString("JEDEC"));
+
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->find<Package>("so-8")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->find<Package>("X175")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindRemovedElement) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym1 name"),
+                                  "the sym1 desc", "the sym1 keywords");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.1"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym2 name"),
+                                  "the sym2 desc", "the sym2 keywords");
+  mWriter->removeElement<Symbol>(toAbs("sym1"));
+
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}), str(mWsDb->find<Symbol>("name")));
+  EXPECT_EQ(str(QList<Uuid>{}), str(mWsDb->find<Symbol>("sym1")));
+}
+
 /*******************************************************************************
  *  Tests for getTranslations()
  ******************************************************************************/
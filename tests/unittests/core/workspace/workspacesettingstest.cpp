@@ -94,6 +94,7 @@ TEST_F(WorkspaceSettingsTest, testLoadFromSExpressionCurrentVersion) {
       " (library_norm_order\n"
       "  (norm \"IEC 60617\")\n"
       " )\n"
+      " (library_element_cache_size 100)\n"
       " (api_endpoints\n"
       "  (url \"https://api.librepcb.org\")\n"
       " )\n"
@@ -122,6 +123,7 @@ TEST_F(WorkspaceSettingsTest, testLoadFromSExpressionCurrentVersion) {
   EXPECT_EQ(true, obj.useOpenGl.get());
   EXPECT_EQ(QStringList{"de_DE"}, obj.libraryLocaleOrder.get());
   EXPECT_EQ(QStringList{"IEC 60617"}, obj.libraryNormOrder.get());
+  EXPECT_EQ(100U, obj.libraryElementCacheSizeMb.get());
   EXPECT_EQ(QList<QUrl>{QUrl("https://api.librepcb.org")},
             obj.apiEndpoints.get());
   EXPECT_EQ(QStringList{"firefox \"{{URL}}\""},
@@ -144,6 +146,7 @@ TEST_F(WorkspaceSettingsTest, testStoreAndLoad) {
   obj1.useOpenGl.set(!obj1.useOpenGl.get());
   obj1.libraryLocaleOrder.set({"de_CH", "en_US"});
   obj1.libraryNormOrder.set({"foo", "bar"});
+  obj1.libraryElementCacheSizeMb.set(123);
   obj1.apiEndpoints.set({QUrl("https://foo"), QUrl("https://bar")});
   obj1.externalWebBrowserCommands.set({"foo", "bar"});
   obj1.externalFileManagerCommands.set({"file", "manager"});
@@ -164,6 +167,8 @@ TEST_F(WorkspaceSettingsTest, testStoreAndLoad) {
   EXPECT_EQ(obj1.useOpenGl.get(), obj2.useOpenGl.get());
   EXPECT_EQ(obj1.libraryLocaleOrder.get(), obj2.libraryLocaleOrder.get());
   EXPECT_EQ(obj1.libraryNormOrder.get(), obj2.libraryNormOrder.get());
+  EXPECT_EQ(obj1.libraryElementCacheSizeMb.get(),
+            obj2.libraryElementCacheSizeMb.get());
   EXPECT_EQ(obj1.apiEndpoints.get(), obj2.apiEndpoints.get());
   EXPECT_EQ(obj1.externalWebBrowserCommands.get(),
             obj2.externalWebBrowserCommands.get());
@@ -0,0 +1,180 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/editor/library/libraryelementcache.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+/**
+ * @brief Checks the caching behavior of ::librepcb::editor::LibraryElementCache
+ *
+ * The symbols created by these tests are smaller than 1 kB, so each of them
+ * has a cost of 1. To find out which elements are cached, their directories
+ * are removed from disk since only cached elements can be accessed then.
+ */
+class LibraryElementCacheTest : public ::testing::Test {
+protected:
+  FilePath mWsDir;
+  std::unique_ptr<WorkspaceLibraryDb> mWsDb;
+  std::shared_ptr<TransactionalFileSystem> mFs;
+
+  LibraryElementCacheTest() : mWsDir(FilePath::getRandomTempPath()) {
+    FileUtils::makePath(mWsDir);
+    mWsDb.reset(new WorkspaceLibraryDb(mWsDir));
+    mFs.reset(new TransactionalFileSystem(mWsDir, true));
+  }
+
+  virtual ~LibraryElementCacheTest() {
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  QList<FilePath> createSymbols(int count) {
+    QList<FilePath> fps;
+    for (int i = 0; i < count; ++i) {
+      const Uuid uuid = Uuid::createRandom();
+      TransactionalDirectory dir(mFs, uuid.toStr());
+      Symbol symbol(uuid, Version::fromString("0.1"), "",
+                    ElementName("sym " % QString::number(i)), "", "");
+      symbol.saveTo(dir);
+      fps.append(mWsDir.getPathTo(uuid.toStr()));
+    }
+    mFs->save();
+    return fps;
+  }
+
+  static void removeFromDisk(const QList<FilePath>& fps) {
+    foreach (const FilePath& fp, fps) {
+      FileUtils::removeDirRecursively(fp);
+    }
+  }
+
+  static bool isCached(const LibraryElementCache& cache, const FilePath& fp) {
+    try {
+      return cache.getElement<Symbol>(fp) != nullptr;
+    } catch (const Exception&) {
+      return false;
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(LibraryElementCacheTest, testElementIsLoadedOnlyOnce) {
+  const QList<FilePath> fps = createSymbols(1);
+  LibraryElementCache cache(*mWsDb);
+  std::shared_ptr<const Symbol> symbol = cache.getElement<Symbol>(fps.first());
+  EXPECT_EQ(symbol, cache.getElement<Symbol>(fps.first()));
+}
+
+TEST_F(LibraryElementCacheTest, testLeastRecentlyUsedElementIsDiscarded) {
+  const QList<FilePath> fps = createSymbols(3);
+  LibraryElementCache cache(*mWsDb, 2);
+  cache.getElement<Symbol>(fps.at(0));
+  cache.getElement<Symbol>(fps.at(1));
+  cache.getElement<Symbol>(fps.at(0));  // Now more recently used than 1.
+  cache.getElement<Symbol>(fps.at(2));  // Discards 1.
+  removeFromDisk(fps);
+  EXPECT_TRUE(isCached(cache, fps.at(0)));
+  EXPECT_FALSE(isCached(cache, fps.at(1)));
+  EXPECT_TRUE(isCached(cache, fps.at(2)));
+}
+
+TEST_F(LibraryElementCacheTest, testMemoryBudget) {
+  const QList<FilePath> fps = createSymbols(5);
+  LibraryElementCache cache(*mWsDb, 3);
+  EXPECT_EQ(3, cache.getMemoryBudget());
+  foreach (const FilePath& fp, fps) {
+    cache.getElement<Symbol>(fp);
+  }
+  removeFromDisk(fps);
+  EXPECT_FALSE(isCached(cache, fps.at(0)));
+  EXPECT_FALSE(isCached(cache, fps.at(1)));
+  EXPECT_TRUE(isCached(cache, fps.at(2)));
+  EXPECT_TRUE(isCached(cache, fps.at(3)));
+  EXPECT_TRUE(isCached(cache, fps.at(4)));
+}
+
+TEST_F(LibraryElementCacheTest, testElementLargerThanBudgetIsNotCached) {
+  const QList<FilePath> fps = createSymbols(1);
+  LibraryElementCache cache(*mWsDb, 0);
+  EXPECT_TRUE(cache.getElement<Symbol>(fps.first()) != nullptr);
+  removeFromDisk(fps);
+  EXPECT_FALSE(isCached(cache, fps.first()));
+}
+
+TEST_F(LibraryElementCacheTest, testPrefetch) {
+  const QList<FilePath> fps = createSymbols(2);
+  LibraryElementCache cache(*mWsDb);
+  cache.prefetch<Symbol>(fps);
+  QThreadPool::globalInstance()->waitForDone();
+  removeFromDisk(fps);
+  foreach (const FilePath& fp, fps) {
+    std::shared_ptr<const Symbol> symbol = cache.getElement<Symbol>(fp);
+    EXPECT_EQ(QThread::currentThread(), symbol->thread());
+  }
+}
+
+TEST_F(LibraryElementCacheTest, testPrefetchNonExistingElement) {
+  const FilePath fp = mWsDir.getPathTo("nonexistent");
+  LibraryElementCache cache(*mWsDb);
+  cache.prefetch<Symbol>({fp});
+  EXPECT_THROW(cache.getElement<Symbol>(fp), Exception);
+}
+
+TEST_F(LibraryElementCacheTest, testClearDiscardsRunningPrefetches) {
+  const QList<FilePath> fps = createSymbols(2);
+  LibraryElementCache cache(*mWsDb);
+  cache.prefetch<Symbol>(fps);
+  cache.clear();
+  QThreadPool::globalInstance()->waitForDone();
+  removeFromDisk(fps);
+  EXPECT_FALSE(isCached(cache, fps.at(0)));
+  EXPECT_FALSE(isCached(cache, fps.at(1)));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb